@@ -4,66 +4,47 @@
 // http://allenchou.net/2013/05/memory-management-part-2-of-3-stl-compatible-allocators/
 // http://allenchou.net/2013/05/memory-management-part-3-of-3-stl-compatible-allocators/
 
-#include "Module/MemoryManager.h"
+#include "Common/MemoryResource.h"
 
 namespace Rocket
 {
-	template<typename T>
-	class Allocator
-	{
-	public:
-        typedef T value_type;
-        typedef T* pointer;
-        typedef T& reference;
-        typedef const T* const_pointer;
-        typedef const T& const_reference;
-        typedef unsigned size_type;
-        typedef unsigned difference_type;
-
+    // STL adapter over a std::pmr::memory_resource, the shared pool resource
+    // unless one is given. Unlike std::pmr::polymorphic_allocator it follows
+    // its container on copy, move and swap, so it can back persistent members
+    template<typename T>
+    class Allocator
+    {
+    public:
+        using value_type = T;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+
+        Allocator() noexcept : m_pResource(GetPoolMemoryResource()) {}
+        Allocator(std::pmr::memory_resource* resource) noexcept : m_pResource(resource) {}
         template <typename U>
-        struct rebind
-        {
-            typedef Allocator<U> other;
-        };
-
-        pointer allocate(unsigned n)
-        {
-            return reinterpret_cast<T*>(g_MemoryManager->Allocate(sizeof(T) * n));
-        }
+        Allocator(const Allocator<U>& other) noexcept : m_pResource(other.GetResource()) {}
 
-        void deallocate(pointer p, unsigned n)
+        T* allocate(size_type n)
         {
-            g_MemoryManager->Free(p, sizeof(T) * n);
+            return static_cast<T*>(m_pResource->allocate(sizeof(T) * n, alignof(T)));
         }
 
-        void construct(pointer p, const_reference clone)
+        void deallocate(T* p, size_type n) noexcept
         {
-            new (p) T(clone);
+            m_pResource->deallocate(p, sizeof(T) * n, alignof(T));
         }
 
-        void destroy(pointer p)
-        {
-            p->~T();
-        }
-
-        pointer address(reference x) const
-        {
-            return &x;
-        }
+        std::pmr::memory_resource* GetResource() const noexcept { return m_pResource; }
 
-        const_pointer address(const_reference x) const
-        {
-            return &x;
-        }
-
-        bool operator==(const Allocator& rhs)
-        {
-            return true;
-        }
+        template <typename U>
+        bool operator==(const Allocator<U>& rhs) const noexcept { return m_pResource->is_equal(*rhs.GetResource()); }
+        template <typename U>
+        bool operator!=(const Allocator<U>& rhs) const noexcept { return !operator==(rhs); }
 
-        bool operator!=(const Allocator& rhs)
-        {
-            return !operator==(rhs);
-        }
-	};
-}
\ No newline at end of file
+    private:
+        std::pmr::memory_resource* m_pResource;
+    };
+}
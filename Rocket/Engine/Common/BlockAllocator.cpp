@@ -4,11 +4,11 @@
 #include <cassert>
 #include <cstdlib>
 #include <cstring>
+#include <new>
 
 using namespace Rocket;
 
 BlockAllocator::BlockAllocator(size_t data_size, size_t page_size, size_t alignment)
-    : m_pPageList(nullptr), m_pFreeList(nullptr)
 {
     Reset(data_size, page_size, alignment);
 }
@@ -25,12 +25,19 @@ void BlockAllocator::Reset(size_t data_size, size_t page_size, size_t alignment)
     // we use a assert to guarantee it
 #if defined(RK_DEBUG)
     RK_CORE_ASSERT(alignment > 0 && ((alignment & (alignment - 1))) == 0, "Alignment Error");
+    // blocks find their page by masking the address
+    RK_CORE_ASSERT((page_size & (page_size - 1)) == 0, "Page Size Error");
 #endif
     m_szBlockSize = RK_ALIGN(minimal_size, alignment);
+    m_szAlignment = alignment;
 
     m_szAlignmentSize = m_szBlockSize - minimal_size;
 
-    m_nBlocksPerPage = (m_szPageSize - sizeof(PageHeader)) / m_szBlockSize;
+    // pages come aligned from the memory manager, so padding the header
+    // keeps every block in the page aligned as well
+    m_szBlockOffset = RK_ALIGN(sizeof(PageHeader), alignment);
+
+    m_nBlocksPerPage = (m_szPageSize - m_szBlockOffset) / m_szBlockSize;
 }
 
 void* BlockAllocator::Allocate(size_t size)
@@ -41,42 +48,34 @@ void* BlockAllocator::Allocate(size_t size)
 
 void* BlockAllocator::Allocate()
 {
-    if (!m_pFreeList)
+    PageHeader* pPage = m_pPartialPages;
+    if (!pPage)
     {
-        // allocate a new page
-        //PageHeader* pNewPage = reinterpret_cast<PageHeader*>(new uint8_t[m_szPageSize]);
-        auto* pNewPage = reinterpret_cast<PageHeader*>(g_MemoryManager->AllocatePage(m_szPageSize));
-        ++m_nPages;
-        m_nBlocks += m_nBlocksPerPage;
-        m_nFreeBlocks += m_nBlocksPerPage;
-
-#if defined(RK_DEBUG)
-        FillFreePage(pNewPage);
-#endif
-
-        if (m_pPageList)
-            pNewPage->pNext = m_pPageList;
+        // reuse an empty page before asking for a new one
+        pPage = m_pEmptyPages;
+        if (pPage)
+        {
+            UnlinkPage(m_pEmptyPages, pPage);
+            --m_nEmptyPages;
+        }
         else
-            pNewPage->pNext = nullptr;
-
-        m_pPageList = pNewPage;
-
-        BlockHeader* pBlock = pNewPage->Blocks();
-        // link each block in the page
-        for (uint32_t i = 0; i < m_nBlocksPerPage - 1; i++)
         {
-            pBlock->pNext = NextBlock(pBlock);
-            pBlock = NextBlock(pBlock);
+            pPage = NewPage();
         }
-        pBlock->pNext = nullptr;
-
-        m_pFreeList = pNewPage->Blocks();
+        LinkPage(m_pPartialPages, pPage);
     }
 
-    BlockHeader* freeBlock = m_pFreeList;
-    m_pFreeList = m_pFreeList->pNext;
+    BlockHeader* freeBlock = pPage->pFreeList;
+    pPage->pFreeList = freeBlock->pNext;
+    ++pPage->LiveBlocks;
     --m_nFreeBlocks;
 
+    if (!pPage->pFreeList)
+    {
+        UnlinkPage(m_pPartialPages, pPage);
+        LinkPage(m_pFullPages, pPage);
+    }
+
 #if defined(RK_DEBUG)
     FillAllocatedBlock(freeBlock);
 #endif
@@ -87,19 +86,120 @@ void* BlockAllocator::Allocate()
 void BlockAllocator::Free(void* p)
 {
     auto* block = reinterpret_cast<BlockHeader*>(p);
+    PageHeader* pPage = PageOf(p);
+    bool was_full = (pPage->pFreeList == nullptr);
 
 #if defined(RK_DEBUG)
     FillFreeBlock(block);
 #endif
 
-    block->pNext = m_pFreeList;
-    m_pFreeList = block;
+    block->pNext = pPage->pFreeList;
+    pPage->pFreeList = block;
+    --pPage->LiveBlocks;
     ++m_nFreeBlocks;
+
+    if (pPage->LiveBlocks == 0)
+    {
+        UnlinkPage(was_full ? m_pFullPages : m_pPartialPages, pPage);
+        LinkPage(m_pEmptyPages, pPage);
+        ++m_nEmptyPages;
+    }
+    else if (was_full)
+    {
+        // nearly full pages go to the head so they fill up again first,
+        // leaving sparse pages to drain and become empty
+        UnlinkPage(m_pFullPages, pPage);
+        LinkPage(m_pPartialPages, pPage);
+    }
 }
 
 void BlockAllocator::FreeAll()
 {
-    PageHeader* pPage = m_pPageList;
+    FreePageList(m_pPartialPages);
+    FreePageList(m_pFullPages);
+    FreePageList(m_pEmptyPages);
+
+    m_nPages = 0;
+    m_nBlocks = 0;
+    m_nFreeBlocks = 0;
+    m_nEmptyPages = 0;
+    m_nLiveBlocks = 0;
+    m_nPeakLiveBlocks = 0;
+    m_nRequestedBytes = 0;
+}
+
+size_t BlockAllocator::Trim(size_t max_pages, size_t retain)
+{
+    size_t released = 0;
+    while (released < max_pages && m_nEmptyPages > retain)
+    {
+        PageHeader* pPage = m_pEmptyPages;
+        UnlinkPage(m_pEmptyPages, pPage);
+        --m_nEmptyPages;
+        --m_nPages;
+        m_nBlocks -= m_nBlocksPerPage;
+        m_nFreeBlocks -= m_nBlocksPerPage;
+        g_MemoryManager->FreePage(reinterpret_cast<void*>(pPage));
+        ++released;
+    }
+    return released;
+}
+
+PageHeader* BlockAllocator::NewPage()
+{
+    //PageHeader* pNewPage = reinterpret_cast<PageHeader*>(new uint8_t[m_szPageSize]);
+    auto* pNewPage = reinterpret_cast<PageHeader*>(g_MemoryManager->AllocatePage(m_szPageSize, m_nPageOwner));
+    if (!pNewPage)
+        throw std::bad_alloc();
+    RK_CORE_ASSERT((reinterpret_cast<uintptr_t>(pNewPage) & (m_szPageSize - 1)) == 0, "Page Alignment Error");
+    ++m_nPages;
+    m_nBlocks += m_nBlocksPerPage;
+    m_nFreeBlocks += m_nBlocksPerPage;
+
+#if defined(RK_DEBUG)
+    FillFreePage(pNewPage);
+#endif
+
+    BlockHeader* pBlock = FirstBlock(pNewPage);
+    // link each block in the page
+    for (uint32_t i = 0; i < m_nBlocksPerPage - 1; i++)
+    {
+        pBlock->pNext = NextBlock(pBlock);
+        pBlock = NextBlock(pBlock);
+    }
+    pBlock->pNext = nullptr;
+
+    pNewPage->pNext = nullptr;
+    pNewPage->pPrev = nullptr;
+    pNewPage->pFreeList = FirstBlock(pNewPage);
+    pNewPage->LiveBlocks = 0;
+    return pNewPage;
+}
+
+void BlockAllocator::LinkPage(PageHeader*& list, PageHeader* pPage)
+{
+    pPage->pPrev = nullptr;
+    pPage->pNext = list;
+    if (list)
+        list->pPrev = pPage;
+    list = pPage;
+}
+
+void BlockAllocator::UnlinkPage(PageHeader*& list, PageHeader* pPage)
+{
+    if (pPage->pPrev)
+        pPage->pPrev->pNext = pPage->pNext;
+    else
+        list = pPage->pNext;
+    if (pPage->pNext)
+        pPage->pNext->pPrev = pPage->pPrev;
+    pPage->pNext = nullptr;
+    pPage->pPrev = nullptr;
+}
+
+void BlockAllocator::FreePageList(PageHeader*& list)
+{
+    PageHeader* pPage = list;
     while (pPage)
     {
         PageHeader* _p = pPage;
@@ -107,23 +207,41 @@ void BlockAllocator::FreeAll()
         g_MemoryManager->FreePage(reinterpret_cast<void*>(_p));
         //delete[] reinterpret_cast<uint8_t*>(_p);
     }
+    list = nullptr;
+}
 
-    m_pPageList = nullptr;
-    m_pFreeList = nullptr;
+void BlockAllocator::Account(ptrdiff_t live_blocks, ptrdiff_t requested_bytes)
+{
+    m_nLiveBlocks += live_blocks;
+    m_nRequestedBytes += requested_bytes;
+    if (m_nLiveBlocks > m_nPeakLiveBlocks)
+        m_nPeakLiveBlocks = m_nLiveBlocks;
+}
 
-    m_nPages = 0;
-    m_nBlocks = 0;
-    m_nFreeBlocks = 0;
+BlockAllocatorStats BlockAllocator::GetStats() const
+{
+    BlockAllocatorStats stats;
+    stats.BlockSize = m_szBlockSize;
+    stats.Alignment = m_szAlignment;
+    stats.Pages = m_nPages;
+    stats.Blocks = m_nBlocks;
+    stats.FreeBlocks = m_nFreeBlocks;
+    stats.EmptyPages = m_nEmptyPages;
+    // a free can be accounted before the matching allocation, clamp at zero
+    stats.LiveBlocks = m_nLiveBlocks > 0 ? static_cast<size_t>(m_nLiveBlocks) : 0;
+    stats.PeakLiveBlocks = static_cast<size_t>(m_nPeakLiveBlocks);
+    stats.RequestedBytes = m_nRequestedBytes > 0 ? static_cast<size_t>(m_nRequestedBytes) : 0;
+    return stats;
 }
 
 #if defined(RK_DEBUG)
 void BlockAllocator::FillFreePage(PageHeader* pPage)
 {
     // page header
-    pPage->pNext = nullptr;
+    memset(pPage, 0, sizeof(PageHeader));
 
     // blocks
-    BlockHeader* pBlock = pPage->Blocks();
+    BlockHeader* pBlock = FirstBlock(pPage);
     for (uint32_t i = 0; i < m_nBlocksPerPage; i++)
     {
         FillFreeBlock(pBlock);
@@ -149,7 +267,17 @@ void BlockAllocator::FillAllocatedBlock(BlockHeader* pBlock) {
 }
 #endif
 
+BlockHeader* BlockAllocator::FirstBlock(PageHeader* pPage)
+{
+    return reinterpret_cast<BlockHeader*>(reinterpret_cast<uint8_t*>(pPage) + m_szBlockOffset);
+}
+
 BlockHeader* BlockAllocator::NextBlock(BlockHeader* pBlock)
 {
     return reinterpret_cast<BlockHeader*>(reinterpret_cast<uint8_t*>(pBlock) + m_szBlockSize);
 }
+
+PageHeader* BlockAllocator::PageOf(void* p)
+{
+    return reinterpret_cast<PageHeader*>(reinterpret_cast<uintptr_t>(p) & ~(m_szPageSize - 1));
+}
@@ -1,6 +1,8 @@
 #pragma once
 #include "Interface/IAllocator.h"
 
+#include <cstddef>
+
 namespace Rocket
 {
     struct BlockHeader
@@ -11,10 +13,38 @@ namespace Rocket
 
     struct PageHeader
     {
+        // links in the partial, full or empty page list
         PageHeader* pNext;
+        PageHeader* pPrev;
+        // free blocks of this page
+        BlockHeader* pFreeList;
+        // blocks handed out of this page
+        size_t LiveBlocks;
         BlockHeader* Blocks() { return reinterpret_cast<BlockHeader*>(this + 1); }
     };
 
+    struct BlockAllocatorStats
+    {
+        size_t BlockSize = 0;
+        size_t Alignment = 0;
+        size_t Pages = 0;
+        size_t Blocks = 0;          // blocks carved from the pages
+        size_t FreeBlocks = 0;      // blocks in the free lists
+        size_t EmptyPages = 0;      // pages without live blocks, released by Trim
+        size_t LiveBlocks = 0;      // blocks held by callers
+        size_t PeakLiveBlocks = 0;
+        size_t RequestedBytes = 0;  // bytes callers asked for in the live blocks
+
+        // share of carved blocks nobody is using
+        double Fragmentation() const { return Blocks ? double(Blocks - LiveBlocks) / double(Blocks) : 0.0; }
+        // bytes lost by rounding live requests up to the block size
+        size_t RoundingWaste() const
+        {
+            size_t used = LiveBlocks * BlockSize;
+            return used > RequestedBytes ? used - RequestedBytes : 0;
+        }
+    };
+
     class BlockAllocator : implements IAllocator
     {
     public:
@@ -27,6 +57,13 @@ namespace Rocket
 
         // resets the allocator to a new configuration
         void Reset(size_t data_size, size_t page_size, size_t alignment);
+        // tag passed along with page requests to the memory manager
+        void SetPageOwner(uint16_t owner) { m_nPageOwner = owner; }
+
+        // live block and requested byte counts are fed by the owner, which
+        // knows the requested sizes; deltas may arrive batched and out of order
+        void Account(ptrdiff_t live_blocks, ptrdiff_t requested_bytes);
+        BlockAllocatorStats GetStats() const;
 
         // alloc and free blocks
         void* Allocate() final;
@@ -34,6 +71,10 @@ namespace Rocket
         void Free(void* p) final;
         void FreeAll() final;
 
+        // gives up to max_pages empty pages back to the memory manager, keeping
+        // retain of them for the next spike; returns the number released
+        size_t Trim(size_t max_pages, size_t retain);
+
     private:
 #if defined(RK_DEBUG)
         // fill a free page with debug patterns
@@ -44,23 +85,41 @@ namespace Rocket
         void FillAllocatedBlock(BlockHeader* pBlock);
 #endif
 
+        // gets a fresh page with all blocks free
+        PageHeader* NewPage();
+        // gets the first block of a page, aligned past the page header
+        BlockHeader* FirstBlock(PageHeader* pPage);
         // gets the next block
         BlockHeader* NextBlock(BlockHeader* pBlock);
+        // gets the page of a block, pages are aligned to their size
+        PageHeader* PageOf(void* p);
 
-        // the page list
-        PageHeader* m_pPageList = nullptr;
+        static void LinkPage(PageHeader*& list, PageHeader* pPage);
+        static void UnlinkPage(PageHeader*& list, PageHeader* pPage);
+        void FreePageList(PageHeader*& list);
 
-        // the free block list
-        BlockHeader* m_pFreeList = nullptr;
+        // pages with free and live blocks, allocation is served from the head
+        PageHeader* m_pPartialPages = nullptr;
+        // pages without free blocks
+        PageHeader* m_pFullPages = nullptr;
+        // pages without live blocks
+        PageHeader* m_pEmptyPages = nullptr;
 
         size_t m_szPageSize;
+        size_t m_szAlignment;
         size_t m_szAlignmentSize;
         size_t m_szBlockSize;
+        size_t m_szBlockOffset;
         size_t m_nBlocksPerPage;
+        uint16_t m_nPageOwner = 0xFFFF;
 
         // statistics
         size_t m_nPages;
         size_t m_nBlocks;
         size_t m_nFreeBlocks;
+        size_t m_nEmptyPages = 0;
+        ptrdiff_t m_nLiveBlocks = 0;
+        ptrdiff_t m_nPeakLiveBlocks = 0;
+        ptrdiff_t m_nRequestedBytes = 0;
     };
 }
\ No newline at end of file
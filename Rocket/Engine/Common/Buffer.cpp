@@ -0,0 +1,197 @@
+#include "Common/Buffer.h"
+#include "Common/FrameArena.h"
+#include "Module/MemoryManager.h"
+
+#include <cstdlib>
+#include <new>
+
+#if defined(PLATFORM_WINDOWS)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace Rocket;
+
+void* HeapBufferAllocator::Allocate(size_t size, size_t alignment)
+{
+    // malloc already satisfies fundamental alignment
+    if (alignment <= alignof(std::max_align_t))
+        return malloc(size);
+#if defined(PLATFORM_WINDOWS)
+    return _aligned_malloc(size, alignment);
+#else
+    void* p = nullptr;
+    if (posix_memalign(&p, alignment, size) != 0)
+        return nullptr;
+    return p;
+#endif
+}
+
+void HeapBufferAllocator::Free(void* p, size_t size, size_t alignment)
+{
+#if defined(PLATFORM_WINDOWS)
+    if (alignment > alignof(std::max_align_t))
+    {
+        _aligned_free(p);
+        return;
+    }
+#endif
+    free(p);
+}
+
+HeapBufferAllocator* HeapBufferAllocator::Get()
+{
+    static HeapBufferAllocator s_Allocator;
+    return &s_Allocator;
+}
+
+void* PoolBufferAllocator::Allocate(size_t size, size_t alignment)
+{
+    RK_CORE_ASSERT(g_MemoryManager, "PoolBufferAllocator used before MemoryManager");
+    return g_MemoryManager->Allocate(size, alignment);
+}
+
+void PoolBufferAllocator::Free(void* p, size_t size, size_t alignment)
+{
+    g_MemoryManager->Free(p, size, alignment);
+}
+
+PoolBufferAllocator* PoolBufferAllocator::Get()
+{
+    static PoolBufferAllocator s_Allocator;
+    return &s_Allocator;
+}
+
+void* ArenaBufferAllocator::Allocate(size_t size, size_t alignment)
+{
+    return m_pArena->Allocate(size, alignment);
+}
+
+void* MappedBufferAllocator::Allocate(size_t size, size_t alignment)
+{
+#if defined(PLATFORM_WINDOWS)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    RK_CORE_ASSERT(alignment <= static_cast<size_t>(info.dwPageSize), "Mapped Buffer Alignment Error");
+    return VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+    RK_CORE_ASSERT(alignment <= static_cast<size_t>(sysconf(_SC_PAGESIZE)), "Mapped Buffer Alignment Error");
+    void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return p == MAP_FAILED ? nullptr : p;
+#endif
+}
+
+void MappedBufferAllocator::Free(void* p, size_t size, size_t alignment)
+{
+#if defined(PLATFORM_WINDOWS)
+    VirtualFree(p, 0, MEM_RELEASE);
+#else
+    munmap(p, size);
+#endif
+}
+
+MappedBufferAllocator* MappedBufferAllocator::Get()
+{
+    static MappedBufferAllocator s_Allocator;
+    return &s_Allocator;
+}
+
+Buffer::Buffer(size_t size, size_t alignment, IBufferAllocator* allocator) : m_szSize(size), m_szAlignment(alignment)
+{
+    RK_CORE_ASSERT(alignment > 0 && ((alignment & (alignment - 1))) == 0, "Buffer Alignment Error");
+    if (size == 0)
+        return;
+    if (!allocator)
+        allocator = HeapBufferAllocator::Get();
+
+    auto* p = static_cast<uint8_t*>(allocator->Allocate(size, alignment));
+    if (!p)
+        throw std::bad_alloc();
+    if (allocator->NeedsFree())
+        m_pData = Ref<uint8_t>(p, [allocator, size, alignment](uint8_t* v) { allocator->Free(v, size, alignment); });
+    else
+        m_pData = Ref<uint8_t>(p, [](uint8_t*) {});
+}
+
+Buffer Buffer::Adopt(void* data, size_t size, std::function<void(uint8_t*)> deleter)
+{
+    Buffer buffer;
+    buffer.m_pData = Ref<uint8_t>(static_cast<uint8_t*>(data), std::move(deleter));
+    buffer.m_szSize = size;
+    return buffer;
+}
+
+Buffer Buffer::Wrap(const void* data, size_t size)
+{
+    Buffer buffer;
+    // aliasing an empty owner, nothing is freed
+    buffer.m_pData = Ref<uint8_t>(Ref<uint8_t>(), static_cast<uint8_t*>(const_cast<void*>(data)));
+    buffer.m_szSize = size;
+    return buffer;
+}
+
+Buffer Buffer::MapFile(const String& path)
+{
+#if defined(PLATFORM_WINDOWS)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return Buffer();
+    LARGE_INTEGER length;
+    if (!GetFileSizeEx(file, &length) || length.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return Buffer();
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping)
+        return Buffer();
+    void* p = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    // the view keeps the mapping object alive
+    CloseHandle(mapping);
+    if (!p)
+        return Buffer();
+
+    Buffer buffer = Adopt(p, static_cast<size_t>(length.QuadPart), [](uint8_t* v) { UnmapViewOfFile(v); });
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return Buffer();
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0)
+    {
+        close(fd);
+        return Buffer();
+    }
+    size_t size = static_cast<size_t>(info.st_size);
+    // private and writable, writes go to copies of the touched pages
+    void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED)
+        return Buffer();
+    madvise(p, size, MADV_SEQUENTIAL);
+
+    Buffer buffer = Adopt(p, size, [size](uint8_t* v) { munmap(v, size); });
+#endif
+    // mappings start on an OS page
+    buffer.m_szAlignment = 4096;
+    return buffer;
+}
+
+Buffer Buffer::Slice(size_t offset, size_t size) const
+{
+    RK_CORE_ASSERT(offset <= m_szSize && size <= m_szSize - offset, "Buffer Slice Out Of Range");
+    Buffer buffer;
+    buffer.m_pData = Ref<uint8_t>(m_pData, m_pData.get() + offset);
+    buffer.m_szSize = size;
+    // largest power of two dividing both
+    size_t alignment = m_szAlignment;
+    while (alignment > 1 && (offset & (alignment - 1)) != 0)
+        alignment >>= 1;
+    buffer.m_szAlignment = alignment;
+    return buffer;
+}
@@ -1,66 +1,133 @@
 #pragma once
 #include "Core/Core.h"
 
+#include <cstdint>
+#include <functional>
+
 namespace Rocket
 {
+    class FrameArena;
+
+    // Source of Buffer memory, Free gets back the size and alignment passed to Allocate
+    Interface IBufferAllocator
+    {
+    public:
+        virtual ~IBufferAllocator() = default;
+        virtual void* Allocate(size_t size, size_t alignment) = 0;
+        virtual void Free(void* p, size_t size, size_t alignment) = 0;
+        // false when Free does nothing, buffers then keep no pointer to the allocator
+        virtual bool NeedsFree() const { return true; }
+    };
+
+    // aligned heap memory, used when no allocator is given
+    class HeapBufferAllocator : implements IBufferAllocator
+    {
+    public:
+        void* Allocate(size_t size, size_t alignment) final;
+        void Free(void* p, size_t size, size_t alignment) final;
+        static HeapBufferAllocator* Get();
+    };
+
+    // MemoryManager size classes, for many small short lived buffers
+    class PoolBufferAllocator : implements IBufferAllocator
+    {
+    public:
+        void* Allocate(size_t size, size_t alignment) final;
+        void Free(void* p, size_t size, size_t alignment) final;
+        static PoolBufferAllocator* Get();
+    };
+
+    // bump allocated from an arena, Free does nothing and the memory
+    // goes away with the arena reset, so buffers must not be read after it.
+    // They do not refer to the allocator and may outlive it
+    class ArenaBufferAllocator : implements IBufferAllocator
+    {
+    public:
+        explicit ArenaBufferAllocator(FrameArena* arena) : m_pArena(arena) {}
+        void* Allocate(size_t size, size_t alignment) final;
+        void Free(void* p, size_t size, size_t alignment) final {}
+        bool NeedsFree() const final { return false; }
+    private:
+        FrameArena* m_pArena;
+    };
+
+    // whole pages straight from the OS, for large buffers that should be
+    // given back as soon as they die; alignment up to the OS page size
+    class MappedBufferAllocator : implements IBufferAllocator
+    {
+    public:
+        void* Allocate(size_t size, size_t alignment) final;
+        void Free(void* p, size_t size, size_t alignment) final;
+        static MappedBufferAllocator* Get();
+    };
+
+    // Byte buffer with shared ownership of its memory.
+    // Slices point into the same memory and keep it alive, so data can be
+    // handed along (file -> decoder -> staging) without being copied.
+    // Memory comes from an IBufferAllocator, is adopted with a deleter,
+    // mapped from a file, or wrapped without ownership.
     class Buffer
     {
         public:
         Buffer() = default;
+        // sharing is explicit through Slice / Share
         Buffer(const Buffer& rhs) = delete;
         Buffer& operator=(const Buffer& rhs) = delete;
-        ~Buffer()
-        {
-            if (m_pData != nullptr)
-                m_pData.reset();
-            m_pData = nullptr;
-        }
+        ~Buffer() = default;
 
-        explicit Buffer(size_t size, size_t alignment = 4) : m_szSize(size)
-        {
-            m_pData = Ref<uint8_t>(new uint8_t[size], [](uint8_t* v){ delete[]v; });
-        }
+        explicit Buffer(size_t size, size_t alignment = 4, IBufferAllocator* allocator = nullptr);
 
         Buffer(Buffer&& rhs) noexcept
         {
-            m_pData = rhs.m_pData;
+            m_pData = std::move(rhs.m_pData);
             m_szSize = rhs.m_szSize;
-            rhs.m_pData = nullptr;
+            m_szAlignment = rhs.m_szAlignment;
             rhs.m_szSize = 0;
         }
 
         Buffer& operator=(Buffer&& rhs) noexcept
         {
-            m_pData.reset();
-            m_pData = rhs.m_pData;
+            m_pData = std::move(rhs.m_pData);
             m_szSize = rhs.m_szSize;
-            rhs.m_pData = nullptr;
+            m_szAlignment = rhs.m_szAlignment;
             rhs.m_szSize = 0;
             return *this;
         }
 
+        // takes ownership of data, the deleter runs when the last slice dies
+        static Buffer Adopt(void* data, size_t size, std::function<void(uint8_t*)> deleter);
+        // refers to memory owned elsewhere, the caller keeps it alive
+        static Buffer Wrap(const void* data, size_t size);
+        // copy-on-write private mapping of a whole file, empty on failure
+        static Buffer MapFile(const String& path);
+
+        // view of [offset, offset + size) sharing this buffer's memory
+        [[nodiscard]] Buffer Slice(size_t offset, size_t size) const;
+        [[nodiscard]] Buffer Share() const { return Slice(0, m_szSize); }
+
         [[nodiscard]] Ref<uint8_t> GetData() { return m_pData; };
         [[nodiscard]] const Ref<uint8_t> GetData() const { return m_pData; };
+        [[nodiscard]] uint8_t* GetPointer() const { return m_pData.get(); }
         [[nodiscard]] size_t GetDataSize() const { return m_szSize; };
+        [[nodiscard]] size_t GetAlignment() const { return m_szAlignment; }
+        [[nodiscard]] bool Empty() const { return m_szSize == 0; }
 
-        uint8_t* MoveData()
+        void SetData(Ref<uint8_t> data, size_t size)
         {
-            uint8_t* tmp = m_pData.get();
-            m_pData.reset();
-            m_szSize = 0;
-            return tmp;
+            m_pData = std::move(data);
+            m_szSize = size;
+            m_szAlignment = 1;
         }
 
-        void SetData(Ref<uint8_t> data, size_t size)
+        void Reset()
         {
-            if (m_pData != nullptr) 
-                m_pData.reset();
-            m_pData = data;
-            m_szSize = size;
+            m_pData.reset();
+            m_szSize = 0;
         }
 
     protected:
         Ref<uint8_t> m_pData{nullptr};
         size_t m_szSize{0};
+        size_t m_szAlignment{1};
     };
-}
\ No newline at end of file
+}
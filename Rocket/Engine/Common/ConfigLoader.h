@@ -29,6 +29,10 @@ namespace Rocket
             m_ConfigMap["Graphics"] = YAML::LoadFile(config_file);
             config_file = m_Path + "/Config/setting-event.yaml";
             m_ConfigMap["Event"] = YAML::LoadFile(config_file);
+            config_file = m_Path + "/Config/setting-memory.yaml";
+            m_ConfigMap["Memory"] = YAML::LoadFile(config_file);
+            config_file = m_Path + "/Config/setting-job.yaml";
+            m_ConfigMap["Job"] = YAML::LoadFile(config_file);
             return 0;
         }
 
@@ -37,6 +41,11 @@ namespace Rocket
             return m_ConfigMap["Path"]["asset_path"].as<String>();
         }
 
+        bool HasConfigInfo(const String& category, const String& name)
+        {
+            return m_ConfigMap[category][name].IsDefined();
+        }
+
         template<typename T>
         T GetConfigInfo(const String& category, const String& name)
         {
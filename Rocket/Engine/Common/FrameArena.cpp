@@ -0,0 +1,94 @@
+#include "Common/FrameArena.h"
+
+#include <cstdlib>
+
+using namespace Rocket;
+
+FrameArena* Rocket::g_FrameArena = nullptr;
+
+FrameArena::FrameArena(size_t capacity) : m_szCapacity(capacity)
+{
+    m_pBlock = static_cast<uint8_t*>(malloc(m_szCapacity));
+    if (!m_pBlock)
+        throw std::bad_alloc();
+    m_Stats.Capacity = m_szCapacity;
+}
+
+FrameArena::~FrameArena()
+{
+    // not Reset(), which may grow the block
+    while (m_pOverflow)
+    {
+        ChunkHeader* pChunk = m_pOverflow;
+        m_pOverflow = m_pOverflow->pNext;
+        free(pChunk);
+    }
+    free(m_pBlock);
+}
+
+void* FrameArena::Allocate(size_t size, size_t alignment)
+{
+#if defined(RK_DEBUG)
+    RK_CORE_ASSERT(alignment > 0 && ((alignment & (alignment - 1))) == 0, "Alignment Error");
+#endif
+    ++m_Stats.Allocations;
+    m_szRequested += size + alignment - 1;
+
+    // bump inside the main block
+    uintptr_t base = reinterpret_cast<uintptr_t>(m_pBlock);
+    uintptr_t aligned = RK_ALIGN(base + m_szOffset, alignment);
+    size_t end = aligned - base + size;
+    if (end <= m_szCapacity)
+    {
+        m_Stats.AllocatedBytes += end - m_szOffset;
+        m_szOffset = end;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    // out of space, spill to a heap chunk that lives until Reset
+    ++m_Stats.OverflowAllocations;
+    size_t header = RK_ALIGN(sizeof(ChunkHeader), alignment);
+    auto* pChunk = static_cast<ChunkHeader*>(malloc(header + size + alignment));
+    if (!pChunk)
+        throw std::bad_alloc();
+    pChunk->pNext = m_pOverflow;
+    m_pOverflow = pChunk;
+    m_Stats.AllocatedBytes += size;
+    return reinterpret_cast<void*>(RK_ALIGN(reinterpret_cast<uintptr_t>(pChunk) + header, alignment));
+}
+
+void FrameArena::Reset()
+{
+    while (m_pOverflow)
+    {
+        ChunkHeader* pChunk = m_pOverflow;
+        m_pOverflow = m_pOverflow->pNext;
+        free(pChunk);
+    }
+
+    bool grow = m_Stats.OverflowAllocations > 0 && m_szRequested > m_szCapacity;
+    size_t requested = m_szRequested;
+    m_LastFrameStats = m_Stats;
+    m_Stats = {};
+    m_Stats.Capacity = m_szCapacity;
+    m_szOffset = 0;
+    m_szRequested = 0;
+
+    // grow so that the next frame of the same size fits in the main block,
+    // on failure the arena stays usable with the old one
+    if (grow)
+    {
+        size_t capacity = RK_ALIGN(requested + requested / 2, alignof(std::max_align_t));
+        auto* pBlock = static_cast<uint8_t*>(malloc(capacity));
+        if (!pBlock)
+        {
+            // only an optimization, the next frame spills again
+            RK_CORE_WARN("Frame arena cannot grow to {} bytes, keeping {}", capacity, m_szCapacity);
+            return;
+        }
+        free(m_pBlock);
+        m_pBlock = pBlock;
+        m_szCapacity = capacity;
+        m_Stats.Capacity = m_szCapacity;
+    }
+}
@@ -0,0 +1,123 @@
+#pragma once
+#include "Core/Core.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+namespace Rocket
+{
+    struct FrameArenaStats
+    {
+        size_t Allocations = 0;         // number of allocations in the frame
+        size_t AllocatedBytes = 0;      // bytes handed out, including alignment padding
+        size_t OverflowAllocations = 0; // allocations that did not fit and went to the heap
+        size_t Capacity = 0;            // size of the main block
+    };
+
+    // Linear (bump) allocator for data that dies within a frame.
+    // Nothing is freed individually, Reset() releases everything at once.
+    // When the main block runs out, allocation spills to heap chunks and the
+    // main block grows to the peak usage on the next Reset(), so a steady
+    // workload ends up with no heap traffic at all. Not thread safe.
+    class FrameArena
+    {
+    public:
+        explicit FrameArena(size_t capacity);
+        ~FrameArena();
+        // disable copy & assignment
+        FrameArena(const FrameArena& clone) = delete;
+        FrameArena& operator=(const FrameArena& rhs) = delete;
+
+        void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+        void Reset();
+
+        template<typename T>
+        T* AllocateArray(size_t count) { return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T))); }
+
+        // statistics of the frame in progress and of the last finished frame
+        const FrameArenaStats& GetStats() const { return m_Stats; }
+        const FrameArenaStats& GetLastFrameStats() const { return m_LastFrameStats; }
+
+    private:
+        struct ChunkHeader
+        {
+            ChunkHeader* pNext;
+        };
+
+        uint8_t* m_pBlock = nullptr;
+        size_t m_szCapacity = 0;
+        size_t m_szOffset = 0;
+        // bytes requested in the frame, used to grow the main block
+        size_t m_szRequested = 0;
+        // heap chunks used after the main block ran out
+        ChunkHeader* m_pOverflow = nullptr;
+
+        FrameArenaStats m_Stats;
+        FrameArenaStats m_LastFrameStats;
+    };
+
+    // Arena of the frame being recorded, owned and cycled by GraphicsManager.
+    // Only use it from the main thread, it is null before graphics initialize.
+    extern FrameArena* g_FrameArena;
+
+    // STL adapter over FrameArena. A default constructed allocator (no arena)
+    // falls back to the heap, so containers typed with it can still be used
+    // for persistent data; transient containers pass FrameAllocator<T>::Current().
+    template<typename T>
+    class FrameAllocator
+    {
+    public:
+        using value_type = T;
+        // containers must not carry arena memory out of the frame
+        using propagate_on_container_copy_assignment = std::false_type;
+        using propagate_on_container_move_assignment = std::false_type;
+        using propagate_on_container_swap = std::false_type;
+
+        FrameAllocator() noexcept = default;
+        explicit FrameAllocator(FrameArena* arena) noexcept : m_pArena(arena) {}
+        template<typename U>
+        FrameAllocator(const FrameAllocator<U>& other) noexcept : m_pArena(other.GetArena()) {}
+
+        static FrameAllocator Current() noexcept { return FrameAllocator(g_FrameArena); }
+
+        T* allocate(size_t n)
+        {
+            if (n > std::numeric_limits<size_t>::max() / sizeof(T))
+                throw std::bad_array_new_length();
+            if (m_pArena)
+                return m_pArena->AllocateArray<T>(n);
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(T* p, size_t n) noexcept
+        {
+            if (!m_pArena)
+                std::allocator<T>().deallocate(p, n);
+        }
+
+        // copies of a container go to the heap
+        FrameAllocator select_on_container_copy_construction() const noexcept { return FrameAllocator(); }
+
+        FrameArena* GetArena() const noexcept { return m_pArena; }
+
+        template<typename U>
+        bool operator==(const FrameAllocator<U>& rhs) const noexcept { return m_pArena == rhs.GetArena(); }
+        template<typename U>
+        bool operator!=(const FrameAllocator<U>& rhs) const noexcept { return m_pArena != rhs.GetArena(); }
+
+    private:
+        FrameArena* m_pArena = nullptr;
+    };
+
+    template<typename T>
+    using FrameVec = std::vector<T, FrameAllocator<T>>;
+
+    // shared object living in the current frame arena, control block included
+    template<typename T, typename... Arguments>
+    Ref<T> CreateFrameRef(Arguments&&... args)
+    {
+        return std::allocate_shared<T>(FrameAllocator<T>::Current(), std::forward<Arguments>(args)...);
+    }
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include "Core/Core.h"
+#include "Common/FrameArena.h"
 
 //#define EIGEN_DONT_ALIGN_STATICALLY
 #include <Eigen/Eigen>
@@ -33,12 +34,13 @@ using Point2DSet = Rocket::USet<Point2DPtr>;
 
 using Point3D = Eigen::Vector3f;
 using Point3DPtr = Rocket::Ref<Point3D>;
-using Point3DList = Rocket::Vec<Point3DPtr>;
+// heap by default, pass FrameAllocator<T>::Current() for per frame lists
+using Point3DList = std::vector<Point3DPtr, Rocket::FrameAllocator<Point3DPtr>>;
 using Point3DSet = Rocket::USet<Point3DPtr>;
 
 using Edge = std::pair<Point3DPtr, Point3DPtr>;
 using EdgePtr = Rocket::Ref<Edge>;
-using EdgeList = Rocket::Vec<EdgePtr>;
+using EdgeList = std::vector<EdgePtr, Rocket::FrameAllocator<EdgePtr>>;
 using EdgeSet = Rocket::USet<EdgePtr>;
 
 struct Face
@@ -0,0 +1,139 @@
+#include "Common/MemoryResource.h"
+#include "Common/FrameArena.h"
+#include "Module/MemoryManager.h"
+
+#include <algorithm>
+#include <mutex>
+
+using namespace Rocket;
+
+// function statics, resources may be created during static initialization
+static std::mutex& RegistryMutex()
+{
+    static std::mutex s_Mutex;
+    return s_Mutex;
+}
+
+static Vec<TrackedMemoryResource*>& Registry()
+{
+    static Vec<TrackedMemoryResource*> s_Resources;
+    return s_Resources;
+}
+
+TrackedMemoryResource::TrackedMemoryResource(const char* name) : m_Name(name)
+{
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    Registry().push_back(this);
+}
+
+TrackedMemoryResource::~TrackedMemoryResource()
+{
+    if (m_nAllocations.load(std::memory_order_relaxed) > 0)
+        RK_CORE_WARN("Memory resource {} destroyed with {} live allocations", m_Name, m_nAllocations.load());
+
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    auto& resources = Registry();
+    resources.erase(std::remove(resources.begin(), resources.end(), this), resources.end());
+}
+
+MemoryResourceStats TrackedMemoryResource::GetStats() const
+{
+    MemoryResourceStats stats;
+    stats.Name = m_Name;
+    stats.Allocations = m_nAllocations.load(std::memory_order_relaxed);
+    stats.LiveBytes = m_szLiveBytes.load(std::memory_order_relaxed);
+    stats.PeakBytes = m_szPeakBytes.load(std::memory_order_relaxed);
+    stats.TotalBytes = m_szTotalBytes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void TrackedMemoryResource::TrackAllocate(size_t bytes)
+{
+    m_nAllocations.fetch_add(1, std::memory_order_relaxed);
+    m_szTotalBytes.fetch_add(bytes, std::memory_order_relaxed);
+    size_t live = m_szLiveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    size_t peak = m_szPeakBytes.load(std::memory_order_relaxed);
+    while (live > peak && !m_szPeakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+}
+
+void TrackedMemoryResource::TrackFree(size_t bytes)
+{
+    m_nAllocations.fetch_sub(1, std::memory_order_relaxed);
+    m_szLiveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+void* PoolMemoryResource::do_allocate(size_t bytes, size_t alignment)
+{
+    RK_CORE_ASSERT(MemoryManager::IsInitialized(), "Memory Resource Allocate Before Memory Manager Initialize");
+    // the name tags the allocation in leak reports
+    void* p = g_MemoryManager->Allocate(bytes, alignment, m_Name, 0);
+    TrackAllocate(bytes);
+    return p;
+}
+
+void PoolMemoryResource::do_deallocate(void* p, size_t bytes, size_t alignment)
+{
+    TrackFree(bytes);
+    // blocks released after Finalize went away with their pages
+    if (MemoryManager::IsInitialized())
+        g_MemoryManager->Free(p, bytes, alignment);
+}
+
+void* ArenaMemoryResource::do_allocate(size_t bytes, size_t alignment)
+{
+    TrackAllocate(bytes);
+    return m_pArena->Allocate(bytes, alignment);
+}
+
+void ArenaMemoryResource::do_deallocate(void* p, size_t bytes, size_t alignment)
+{
+    TrackFree(bytes);
+}
+
+ThreadLocalMemoryResource::ThreadLocalMemoryResource(const char* name, std::pmr::memory_resource* upstream)
+    : TrackedMemoryResource(name), m_Pools(upstream)
+{
+#if defined(RK_DEBUG)
+    m_Owner = std::this_thread::get_id();
+#endif
+}
+
+ThreadLocalMemoryResource* ThreadLocalMemoryResource::Get()
+{
+    thread_local ThreadLocalMemoryResource s_Resource("ThreadLocal", GetPoolMemoryResource());
+    return &s_Resource;
+}
+
+void* ThreadLocalMemoryResource::do_allocate(size_t bytes, size_t alignment)
+{
+#if defined(RK_DEBUG)
+    RK_CORE_ASSERT(m_Owner == std::this_thread::get_id(), "Thread Local Memory Resource Used From Another Thread");
+#endif
+    void* p = m_Pools.allocate(bytes, alignment);
+    TrackAllocate(bytes);
+    return p;
+}
+
+void ThreadLocalMemoryResource::do_deallocate(void* p, size_t bytes, size_t alignment)
+{
+#if defined(RK_DEBUG)
+    RK_CORE_ASSERT(m_Owner == std::this_thread::get_id(), "Thread Local Memory Resource Used From Another Thread");
+#endif
+    TrackFree(bytes);
+    m_Pools.deallocate(p, bytes, alignment);
+}
+
+std::pmr::memory_resource* Rocket::GetPoolMemoryResource()
+{
+    static PoolMemoryResource s_Resource("General");
+    return &s_Resource;
+}
+
+Vec<MemoryResourceStats> Rocket::GetMemoryResourceStats()
+{
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    Vec<MemoryResourceStats> result;
+    for (auto resource : Registry())
+        result.push_back(resource->GetStats());
+    return result;
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include "Core/Core.h"
+
+#include <atomic>
+#include <memory_resource>
+#include <thread>
+
+namespace Rocket
+{
+    class FrameArena;
+
+    struct MemoryResourceStats
+    {
+        const char* Name = nullptr;
+        size_t Allocations = 0;     // live allocations
+        size_t LiveBytes = 0;
+        size_t PeakBytes = 0;
+        size_t TotalBytes = 0;      // bytes ever allocated
+    };
+
+    // memory_resource that counts what goes through it, every live instance
+    // shows up in GetMemoryResourceStats() under its name
+    class TrackedMemoryResource : public std::pmr::memory_resource
+    {
+    public:
+        explicit TrackedMemoryResource(const char* name);
+        virtual ~TrackedMemoryResource();
+        // disable copy & assignment
+        TrackedMemoryResource(const TrackedMemoryResource& clone) = delete;
+        TrackedMemoryResource& operator=(const TrackedMemoryResource& rhs) = delete;
+
+        const char* GetName() const { return m_Name; }
+        MemoryResourceStats GetStats() const;
+
+    protected:
+        void TrackAllocate(size_t bytes);
+        void TrackFree(size_t bytes);
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+        const char* m_Name;
+
+    private:
+        std::atomic<size_t> m_nAllocations{0};
+        std::atomic<size_t> m_szLiveBytes{0};
+        std::atomic<size_t> m_szPeakBytes{0};
+        std::atomic<size_t> m_szTotalBytes{0};
+    };
+
+    // MemoryManager size classes, thread safe. Must be used between
+    // MemoryManager Initialize and Finalize, like CreateRef
+    class PoolMemoryResource final : public TrackedMemoryResource
+    {
+    public:
+        explicit PoolMemoryResource(const char* name) : TrackedMemoryResource(name) {}
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) final;
+        void do_deallocate(void* p, size_t bytes, size_t alignment) final;
+    };
+
+    // bump allocation from a FrameArena, deallocate does nothing and the
+    // memory goes away with the arena reset. Not thread safe
+    class ArenaMemoryResource final : public TrackedMemoryResource
+    {
+    public:
+        ArenaMemoryResource(const char* name, FrameArena* arena) : TrackedMemoryResource(name), m_pArena(arena) {}
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) final;
+        void do_deallocate(void* p, size_t bytes, size_t alignment) final;
+
+        FrameArena* m_pArena;
+    };
+
+    // unsynchronized pools of one thread over an upstream resource, no locks
+    // or atomics on the hot path; memory must be freed by the same thread
+    class ThreadLocalMemoryResource final : public TrackedMemoryResource
+    {
+    public:
+        ThreadLocalMemoryResource(const char* name, std::pmr::memory_resource* upstream);
+
+        // instance of the calling thread, over the general pool resource
+        static ThreadLocalMemoryResource* Get();
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) final;
+        void do_deallocate(void* p, size_t bytes, size_t alignment) final;
+
+        std::pmr::unsynchronized_pool_resource m_Pools;
+#if defined(RK_DEBUG)
+        std::thread::id m_Owner;
+#endif
+    };
+
+    // shared resource for containers that do not name their own
+    std::pmr::memory_resource* GetPoolMemoryResource();
+    // stats of every live TrackedMemoryResource
+    Vec<MemoryResourceStats> GetMemoryResourceStats();
+}
@@ -0,0 +1,304 @@
+#pragma once
+#include "Core/Core.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Rocket
+{
+    class PoolObject;
+
+    Interface IObjectPool
+    {
+    public:
+        virtual ~IObjectPool() = default;
+        // destroys an object whose last PoolRef went away and keeps its slot
+        virtual void Recycle(PoolObject* object) = 0;
+    };
+
+    // Base of objects shared through PoolRef, carries the intrusive count and
+    // the pool the object goes back to. Objects without a pool are deleted.
+    class PoolObject
+    {
+    public:
+        PoolObject() = default;
+        // a copy is a new object, it does not share count or pool
+        PoolObject(const PoolObject&) noexcept {}
+        PoolObject& operator=(const PoolObject&) noexcept { return *this; }
+        virtual ~PoolObject() = default;
+
+        void AddRef() const noexcept { m_RefCount.fetch_add(1, std::memory_order_relaxed); }
+        void Release() const noexcept
+        {
+            if (m_RefCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                auto* self = const_cast<PoolObject*>(this);
+                if (m_pPool)
+                    m_pPool->Recycle(self);
+                else
+                    delete self;
+            }
+        }
+        uint32_t GetRefCount() const noexcept { return m_RefCount.load(std::memory_order_relaxed); }
+
+    private:
+        template<typename T> friend class ObjectPool;
+
+        mutable std::atomic<uint32_t> m_RefCount{0};
+        IObjectPool* m_pPool = nullptr;
+    };
+
+    // Intrusive shared pointer over PoolObject, one atomic per copy and no
+    // control block, otherwise used like Ref<T>
+    template<typename T>
+    class PoolRef
+    {
+    public:
+        using element_type = T;
+
+        PoolRef() noexcept = default;
+        PoolRef(std::nullptr_t) noexcept {}
+        explicit PoolRef(T* p) noexcept : m_Ptr(p) { if (m_Ptr) m_Ptr->AddRef(); }
+        PoolRef(const PoolRef& other) noexcept : m_Ptr(other.m_Ptr) { if (m_Ptr) m_Ptr->AddRef(); }
+        PoolRef(PoolRef&& other) noexcept : m_Ptr(other.m_Ptr) { other.m_Ptr = nullptr; }
+        template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+        PoolRef(const PoolRef<U>& other) noexcept : m_Ptr(other.get()) { if (m_Ptr) m_Ptr->AddRef(); }
+        template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+        PoolRef(PoolRef<U>&& other) noexcept : m_Ptr(other.Detach()) {}
+        ~PoolRef() { if (m_Ptr) m_Ptr->Release(); }
+
+        PoolRef& operator=(PoolRef other) noexcept { std::swap(m_Ptr, other.m_Ptr); return *this; }
+
+        void reset() noexcept { PoolRef().swap(*this); }
+        void swap(PoolRef& other) noexcept { std::swap(m_Ptr, other.m_Ptr); }
+
+        T* get() const noexcept { return m_Ptr; }
+        T& operator*() const noexcept { return *m_Ptr; }
+        T* operator->() const noexcept { return m_Ptr; }
+        explicit operator bool() const noexcept { return m_Ptr != nullptr; }
+        uint32_t use_count() const noexcept { return m_Ptr ? m_Ptr->GetRefCount() : 0; }
+
+        // gives up ownership without releasing
+        T* Detach() noexcept { T* p = m_Ptr; m_Ptr = nullptr; return p; }
+
+    private:
+        T* m_Ptr = nullptr;
+    };
+
+    template<typename T, typename U>
+    bool operator==(const PoolRef<T>& lhs, const PoolRef<U>& rhs) noexcept { return lhs.get() == rhs.get(); }
+    template<typename T, typename U>
+    bool operator!=(const PoolRef<T>& lhs, const PoolRef<U>& rhs) noexcept { return lhs.get() != rhs.get(); }
+    template<typename T>
+    bool operator==(const PoolRef<T>& lhs, std::nullptr_t) noexcept { return !lhs; }
+    template<typename T>
+    bool operator!=(const PoolRef<T>& lhs, std::nullptr_t) noexcept { return static_cast<bool>(lhs); }
+
+    // Typed slab of T slots with a lock-free free list (Treiber stack with
+    // an ABA tag). Slots come in chunks that are never returned until the
+    // pool dies, so after warm-up creating an object touches no heap at all.
+    // One pool per type, shared by every thread through Get().
+    template<typename T>
+    class ObjectPool final : implements IObjectPool
+    {
+    public:
+        static constexpr uint32_t kChunkSize = 256;
+        static constexpr uint32_t kMaxChunks = 4096;
+
+        ObjectPool() = default;
+        ~ObjectPool()
+        {
+            uint32_t chunks = m_nChunks.load(std::memory_order_acquire);
+            for (uint32_t i = 0; i < chunks; ++i)
+                ::operator delete(m_Chunks[i].load(std::memory_order_relaxed), std::align_val_t(alignof(Slot)));
+        }
+        // disable copy & assignment
+        ObjectPool(const ObjectPool& clone) = delete;
+        ObjectPool& operator=(const ObjectPool& rhs) = delete;
+
+        static ObjectPool& Get()
+        {
+            static ObjectPool s_Pool;
+            return s_Pool;
+        }
+
+        // raw storage for one T, used by PoolRefAllocator
+        void* AllocateSlot()
+        {
+            m_nLive.fetch_add(1, std::memory_order_relaxed);
+            return Pop()->Storage;
+        }
+
+        void FreeSlot(void* p)
+        {
+            Push(reinterpret_cast<Slot*>(p));
+            m_nLive.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        template<typename... Arguments>
+        PoolRef<T> Create(Arguments&&... args)
+        {
+            static_assert(std::is_base_of_v<PoolObject, T>, "PoolRef objects must derive from PoolObject");
+            void* p = AllocateSlot();
+            T* object = nullptr;
+            try
+            {
+                object = new (p) T(std::forward<Arguments>(args)...);
+            }
+            catch (...)
+            {
+                FreeSlot(p);
+                throw;
+            }
+            static_cast<PoolObject*>(object)->m_pPool = this;
+            return PoolRef<T>(object);
+        }
+
+        void Recycle(PoolObject* object) final
+        {
+            // pools behind PoolRefAllocator hold no PoolObject and never get here
+            if constexpr (std::is_base_of_v<PoolObject, T>)
+            {
+                T* p = static_cast<T*>(object);
+                p->~T();
+                FreeSlot(p);
+            }
+        }
+
+        size_t GetCapacity() const { return size_t(m_nChunks.load(std::memory_order_relaxed)) * kChunkSize; }
+        size_t GetLive() const { return m_nLive.load(std::memory_order_relaxed); }
+
+    private:
+        struct Slot
+        {
+            // first member, a T pointer is its slot pointer
+            alignas(T) uint8_t Storage[sizeof(T)];
+            uint32_t Index;
+            std::atomic<uint32_t> Next;
+        };
+
+        static constexpr uint32_t kNullIndex = 0xFFFFFFFF;
+
+        static uint64_t Pack(uint32_t tag, uint32_t index) { return (uint64_t(tag) << 32) | index; }
+        static uint32_t TagOf(uint64_t head) { return uint32_t(head >> 32); }
+        static uint32_t IndexOf(uint64_t head) { return uint32_t(head); }
+
+        Slot* SlotAt(uint32_t index) const
+        {
+            return m_Chunks[index / kChunkSize].load(std::memory_order_acquire) + index % kChunkSize;
+        }
+
+        Slot* Pop()
+        {
+            uint64_t head = m_FreeHead.load(std::memory_order_acquire);
+            while (true)
+            {
+                uint32_t index = IndexOf(head);
+                if (index == kNullIndex)
+                {
+                    Grow();
+                    head = m_FreeHead.load(std::memory_order_acquire);
+                    continue;
+                }
+                // the slot may be taken meanwhile, the tag makes the swap fail then
+                Slot* slot = SlotAt(index);
+                uint32_t next = slot->Next.load(std::memory_order_relaxed);
+                if (m_FreeHead.compare_exchange_weak(head, Pack(TagOf(head) + 1, next),
+                    std::memory_order_acquire, std::memory_order_acquire))
+                    return slot;
+            }
+        }
+
+        void Push(Slot* slot) { PushChain(slot, slot); }
+
+        // pushes first..last, already linked through Next
+        void PushChain(Slot* first, Slot* last)
+        {
+            uint64_t head = m_FreeHead.load(std::memory_order_relaxed);
+            do
+            {
+                last->Next.store(IndexOf(head), std::memory_order_relaxed);
+            } while (!m_FreeHead.compare_exchange_weak(head, Pack(TagOf(head) + 1, first->Index),
+                std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        void Grow()
+        {
+            std::lock_guard<std::mutex> lock(m_GrowMutex);
+            // another thread grew the pool while we waited
+            if (IndexOf(m_FreeHead.load(std::memory_order_acquire)) != kNullIndex)
+                return;
+
+            uint32_t chunk = m_nChunks.load(std::memory_order_relaxed);
+            if (chunk == kMaxChunks)
+                throw std::bad_alloc();
+
+            auto* slots = static_cast<Slot*>(::operator new(sizeof(Slot) * kChunkSize, std::align_val_t(alignof(Slot))));
+            for (uint32_t i = 0; i < kChunkSize; ++i)
+            {
+                new (&slots[i].Next) std::atomic<uint32_t>(chunk * kChunkSize + i + 1);
+                slots[i].Index = chunk * kChunkSize + i;
+            }
+            m_Chunks[chunk].store(slots, std::memory_order_release);
+            m_nChunks.store(chunk + 1, std::memory_order_release);
+            PushChain(&slots[0], &slots[kChunkSize - 1]);
+        }
+
+        std::atomic<uint64_t> m_FreeHead{Pack(0, kNullIndex)};
+        std::atomic<Slot*> m_Chunks[kMaxChunks] = {};
+        std::atomic<uint32_t> m_nChunks{0};
+        std::atomic<size_t> m_nLive{0};
+        std::mutex m_GrowMutex;
+    };
+
+    // shared object living in the pool of its type
+    template<typename T, typename... Arguments>
+    PoolRef<T> CreatePoolRef(Arguments&&... args)
+    {
+        return ObjectPool<T>::Get().Create(std::forward<Arguments>(args)...);
+    }
+
+    // STL adapter that serves single objects from ObjectPool, for types that
+    // need Ref<T> semantics (weak references); the control block shares the slot
+    template<typename T>
+    class PoolRefAllocator
+    {
+    public:
+        using value_type = T;
+
+        PoolRefAllocator() noexcept = default;
+        template<typename U>
+        PoolRefAllocator(const PoolRefAllocator<U>&) noexcept {}
+
+        T* allocate(size_t n)
+        {
+            if (n == 1)
+                return static_cast<T*>(ObjectPool<T>::Get().AllocateSlot());
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(T* p, size_t n) noexcept
+        {
+            if (n == 1)
+                ObjectPool<T>::Get().FreeSlot(p);
+            else
+                std::allocator<T>().deallocate(p, n);
+        }
+
+        template<typename U>
+        bool operator==(const PoolRefAllocator<U>&) const noexcept { return true; }
+        template<typename U>
+        bool operator!=(const PoolRefAllocator<U>&) const noexcept { return false; }
+    };
+
+    // Ref<T> whose object and control block are recycled through an ObjectPool
+    template<typename T, typename... Arguments>
+    Ref<T> CreatePooledRef(Arguments&&... args)
+    {
+        return std::allocate_shared<T>(PoolRefAllocator<T>(), std::forward<Arguments>(args)...);
+    }
+}
@@ -0,0 +1,234 @@
+#include "Common/PageHeap.h"
+
+#include <cstdlib>
+
+#if defined(PLATFORM_WINDOWS)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace Rocket;
+
+static void* ReserveRegion(size_t size)
+{
+#if defined(PLATFORM_WINDOWS)
+    return VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
+#else
+    // the kernel only backs pages that are touched
+    void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    return p == MAP_FAILED ? nullptr : p;
+#endif
+}
+
+static void FreeRegion(void* p, size_t size)
+{
+#if defined(PLATFORM_WINDOWS)
+    VirtualFree(p, 0, MEM_RELEASE);
+#else
+    munmap(p, size);
+#endif
+}
+
+static bool CommitPages(void* p, size_t size)
+{
+#if defined(PLATFORM_WINDOWS)
+    return VirtualAlloc(p, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+#else
+    return true;
+#endif
+}
+
+static void DecommitPages(void* p, size_t size)
+{
+#if defined(PLATFORM_WINDOWS)
+    VirtualFree(p, size, MEM_DECOMMIT);
+#elif defined(PLATFORM_APPLE)
+    madvise(p, size, MADV_FREE);
+#else
+    madvise(p, size, MADV_DONTNEED);
+#endif
+}
+
+bool PageHeap::Initialize(size_t reserve_size, size_t page_size)
+{
+    Finalize();
+
+    m_szPageSize = page_size;
+    m_nPageSlots = reserve_size / page_size;
+    // one spare page so the base can be aligned to the page size
+    m_szRegionSize = (m_nPageSlots + 1) * m_szPageSize;
+    m_pRegion = ReserveRegion(m_szRegionSize);
+    if (!m_pRegion)
+    {
+        m_nPageSlots = 0;
+        return false;
+    }
+    m_pBase = reinterpret_cast<uint8_t*>(RK_ALIGN(reinterpret_cast<uintptr_t>(m_pRegion), m_szPageSize));
+
+    // zeroed memory is all PAGE_RELEASED, calloc keeps the untouched part lazy
+    m_pPageTable = static_cast<PageInfo*>(calloc(m_nPageSlots, sizeof(PageInfo)));
+    if (!m_pPageTable)
+    {
+        FreeRegion(m_pRegion, m_szRegionSize);
+        m_pRegion = nullptr;
+        m_pBase = nullptr;
+        m_nPageSlots = 0;
+        return false;
+    }
+    m_nHighWater = 0;
+    m_nFreeHead = m_nPageSlots;
+    m_nUsedPages = 0;
+    m_nFreePages = 0;
+    return true;
+}
+
+void PageHeap::Finalize()
+{
+    if (m_pRegion)
+        FreeRegion(m_pRegion, m_szRegionSize);
+    free(m_pPageTable);
+    m_pRegion = nullptr;
+    m_pBase = nullptr;
+    m_pPageTable = nullptr;
+    m_nPageSlots = 0;
+}
+
+void* PageHeap::AllocatePage(size_t size, uint16_t owner, MemoryType type)
+{
+    size_t count = (size + m_szPageSize - 1) / m_szPageSize;
+    size_t slot = m_nPageSlots;
+
+    if (count == 1 && m_nFreeHead != m_nPageSlots)
+    {
+        // reuse the most recently freed page, likely still hot
+        slot = m_nFreeHead;
+        m_nFreeHead = m_pPageTable[slot].NextFree;
+    }
+    else if (m_nHighWater + count <= m_nPageSlots)
+    {
+        slot = m_nHighWater;
+        m_nHighWater += count;
+    }
+    else
+    {
+        return nullptr;
+    }
+
+    uint8_t* p = AddressOf(slot);
+    for (size_t i = 0; i < count; ++i)
+    {
+        PageInfo& info = m_pPageTable[slot + i];
+        if (info.State == PAGE_FREE)
+            --m_nFreePages;
+        else if (!CommitPages(p + i * m_szPageSize, m_szPageSize))
+            return nullptr;
+        info.PageCount = (i == 0) ? static_cast<uint32_t>(count) : static_cast<uint32_t>(i);
+        info.Type = type;
+        info.Owner = owner;
+        info.State = (i == 0) ? PAGE_USED : PAGE_TAIL;
+    }
+    m_nUsedPages += count;
+
+    return p;
+}
+
+bool PageHeap::FreePage(void* p)
+{
+    if (!Contains(p))
+        return false;
+
+    size_t slot = SlotOf(p);
+    PageInfo& head = m_pPageTable[slot];
+    RK_CORE_ASSERT(head.State == PAGE_USED && AddressOf(slot) == p, "Free Page Error");
+
+    // pages of a multi page allocation are recycled one by one
+    size_t count = head.PageCount;
+    for (size_t i = 0; i < count; ++i)
+    {
+        PageInfo& info = m_pPageTable[slot + i];
+        info.State = PAGE_FREE;
+        info.Owner = kNoOwner;
+        info.PageCount = 1;
+        info.NextFree = static_cast<uint32_t>(m_nFreeHead);
+        m_nFreeHead = slot + i;
+    }
+    m_nUsedPages -= count;
+    m_nFreePages += count;
+    return true;
+}
+
+size_t PageHeap::ReleaseFreePages()
+{
+    size_t released = 0;
+    size_t slot = 0;
+    while (slot < m_nHighWater)
+    {
+        if (m_pPageTable[slot].State != PAGE_FREE)
+        {
+            ++slot;
+            continue;
+        }
+
+        // coalesce a run of free pages into one call
+        size_t first = slot;
+        while (slot < m_nHighWater && m_pPageTable[slot].State == PAGE_FREE)
+        {
+            m_pPageTable[slot].State = PAGE_RELEASED;
+            ++slot;
+        }
+        DecommitPages(AddressOf(first), (slot - first) * m_szPageSize);
+        released += slot - first;
+    }
+
+    // released pages stay in the free stack and are committed again on reuse
+    m_nFreePages -= released;
+    return released * m_szPageSize;
+}
+
+const PageHeap::PageInfo* PageHeap::LookUp(const void* p) const
+{
+    if (!Contains(p))
+        return nullptr;
+
+    size_t slot = SlotOf(p);
+    const PageInfo* info = m_pPageTable + slot;
+    if (info->State == PAGE_TAIL)
+        info -= info->PageCount;
+    return info->State == PAGE_USED ? info : nullptr;
+}
+
+void PageHeap::QueryUsage(size_t* reserved, size_t* resident, size_t num_owners) const
+{
+    for (size_t i = 0; i < num_owners; ++i)
+    {
+        reserved[i] = 0;
+        resident[i] = 0;
+    }
+
+#if !defined(PLATFORM_WINDOWS)
+    size_t os_page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    Vec<unsigned char> residency((m_szPageSize + os_page_size - 1) / os_page_size);
+#endif
+
+    for (size_t slot = 0; slot < m_nHighWater; ++slot)
+    {
+        const PageInfo& info = m_pPageTable[slot];
+        if (info.Owner >= num_owners || (info.State != PAGE_USED && info.State != PAGE_TAIL))
+            continue;
+
+        reserved[info.Owner] += m_szPageSize;
+#if defined(PLATFORM_WINDOWS)
+        // committed pages count as resident
+        resident[info.Owner] += m_szPageSize;
+#else
+        // ask the kernel which pages are actually backed
+        if (mincore(AddressOf(slot), m_szPageSize, residency.data()) == 0)
+        {
+            for (auto page : residency)
+                resident[info.Owner] += (page & 1) ? os_page_size : 0;
+        }
+#endif
+    }
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include "Core/Core.h"
+#include "Utils/Portable.h"
+
+#include <cstdint>
+#include <cstdlib>
+
+namespace Rocket
+{
+    ENUM(MemoryType){CPU = "CPU"_i32, GPU = "GPU"_i32};
+
+    // Hands out fixed size pages carved from one large reserved virtual region,
+    // every page aligned to the page size.
+    // Pages are committed on first touch and given back to the OS in bulk by
+    // ReleaseFreePages(), while the address range stays reserved. Everything
+    // about a page (owner, size, memory type) is found from its address in O(1)
+    // through a flat page table indexed by (address - base) / page size.
+    // Not thread safe, MemoryManager serializes access.
+    class PageHeap
+    {
+    public:
+        static constexpr uint16_t kNoOwner = 0xFFFF;
+
+        enum PageState : uint8_t
+        {
+            PAGE_RELEASED = 0, // never touched, or given back to the OS
+            PAGE_FREE,         // free but still resident
+            PAGE_USED,         // first page of an allocation
+            PAGE_TAIL,         // following page of a multi page allocation
+        };
+
+        struct PageInfo
+        {
+            uint32_t PageCount;  // pages in the allocation, or offset to the first page for PAGE_TAIL
+            uint32_t NextFree;   // free page stack link
+            MemoryType Type;
+            uint16_t Owner;
+            PageState State;
+        };
+
+        PageHeap() = default;
+        ~PageHeap() { Finalize(); }
+        // disable copy & assignment
+        PageHeap(const PageHeap& clone) = delete;
+        PageHeap& operator=(const PageHeap& rhs) = delete;
+
+        bool Initialize(size_t reserve_size, size_t page_size);
+        void Finalize();
+
+        // returns nullptr once the reserved region is exhausted
+        void* AllocatePage(size_t size, uint16_t owner, MemoryType type = MemoryType::CPU);
+        // returns false if the address was not allocated from this heap
+        bool FreePage(void* p);
+        // madvise / decommit every free page, contiguous pages in one call
+        size_t ReleaseFreePages();
+
+        // page info of any address inside an allocated page, nullptr otherwise
+        const PageInfo* LookUp(const void* p) const;
+        bool Contains(const void* p) const
+        {
+            return p >= m_pBase && p < m_pBase + m_nPageSlots * m_szPageSize;
+        }
+
+        // bytes held by owners [0, num_owners) and how many of them are resident,
+        // walks the page table once; the arrays are overwritten
+        void QueryUsage(size_t* reserved, size_t* resident, size_t num_owners) const;
+
+        size_t GetPageSize() const { return m_szPageSize; }
+        size_t GetReservedBytes() const { return m_nPageSlots * m_szPageSize; }
+        size_t GetUsedBytes() const { return m_nUsedPages * m_szPageSize; }
+        // used pages plus free pages not yet released
+        size_t GetCommittedBytes() const { return (m_nUsedPages + m_nFreePages) * m_szPageSize; }
+
+    private:
+        size_t SlotOf(const void* p) const { return (static_cast<const uint8_t*>(p) - m_pBase) / m_szPageSize; }
+        uint8_t* AddressOf(size_t slot) const { return m_pBase + slot * m_szPageSize; }
+
+        void* m_pRegion = nullptr;
+        size_t m_szRegionSize = 0;
+        uint8_t* m_pBase = nullptr;
+        PageInfo* m_pPageTable = nullptr;
+        size_t m_szPageSize = 0;
+        size_t m_nPageSlots = 0;
+        // slots below this were handed out at least once
+        size_t m_nHighWater = 0;
+        // top of the free page stack, m_nPageSlots when empty
+        size_t m_nFreeHead = 0;
+
+        // statistics
+        size_t m_nUsedPages = 0;
+        size_t m_nFreePages = 0;
+    };
+}
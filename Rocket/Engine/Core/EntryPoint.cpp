@@ -54,6 +54,9 @@ int main(int argc, char **argv)
 
     float CountTime = 0.0f;
     int32_t CountFrame = 0;
+    // whole run, reported at the end for headless benchmarks
+    double TotalTime = 0.0;
+    uint64_t TotalFrame = 0;
 
     ElapseTimer Timer;
     Timer.Start();
@@ -67,6 +70,8 @@ int main(int argc, char **argv)
 
         CountFrame++;
         CountTime += Duration;
+        TotalFrame++;
+        TotalTime += Duration;
 
         if(CountTime >= 1000.0f)
         {
@@ -80,6 +85,8 @@ int main(int argc, char **argv)
 	    PROFILE_END_CPU_SAMPLE();
     }
     RK_PROFILE_END_SESSION();
+    if (TotalFrame > 0)
+        RK_CORE_INFO("Run Loop {0} Frames, {1:.3f} ms Per Frame", TotalFrame, TotalTime / TotalFrame);
     
     RK_PROFILE_BEGIN_SESSION("Finalize", "RocketProfile-Finalize.json");
     app->Finalize();
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <memory_resource>
 #include <vector>
 #include <map>
 #include <set>
@@ -10,6 +11,7 @@
 #include <string>
 #include <queue>
 #include <array>
+#include <type_traits>
 
 namespace Rocket
 {
@@ -19,9 +21,58 @@ namespace Rocket
 		return std::is_base_of<Base, T>::value;
 	}
 
+    // Implemented in MemoryManager.cpp, with USE_MEMORY_MANAGER the memory
+    // manager must outlive every object created through CreateRef / CreateScope
+    void* PoolAllocate(size_t size, size_t alignment);
+    void PoolFree(void* p, size_t size, size_t alignment);
+
+#if defined(USE_MEMORY_MANAGER)
+    template <typename T>
+    struct PoolAllocator
+    {
+        using value_type = T;
+        PoolAllocator() noexcept = default;
+        template <typename U>
+        PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+        T* allocate(size_t n) { return static_cast<T*>(PoolAllocate(sizeof(T) * n, alignof(T))); }
+        void deallocate(T* p, size_t n) noexcept { PoolFree(p, sizeof(T) * n, alignof(T)); }
+
+        template <typename U>
+        bool operator==(const PoolAllocator<U>&) const noexcept { return true; }
+        template <typename U>
+        bool operator!=(const PoolAllocator<U>&) const noexcept { return false; }
+    };
+
+    // Keeps size and alignment of the allocated type, so it still frees
+    // the right size class after converting Scope<Derived> to Scope<Base>
+    template <typename T>
+    struct PoolDeleter
+    {
+        PoolDeleter() noexcept = default;
+        template <typename U>
+        PoolDeleter(const PoolDeleter<U>& other) noexcept : Size(other.Size), Alignment(other.Alignment) {}
+
+        void operator()(T* ptr) const
+        {
+            void* block = ptr;
+            if constexpr (std::is_polymorphic_v<T>)
+                block = dynamic_cast<void*>(ptr);
+            ptr->~T();
+            PoolFree(block, Size, Alignment);
+        }
+
+        size_t Size = sizeof(T);
+        size_t Alignment = alignof(T);
+    };
+
+    template <typename T>
+    using Scope = std::unique_ptr<T, PoolDeleter<T>>;
+#else
 	template <typename T>
     //using Scope = std::unique_ptr<T, std::function<void(T*)>>;
     using Scope = std::unique_ptr<T>;
+#endif
 
     template <typename T>
     using Ref = std::shared_ptr<T>;
@@ -32,18 +83,29 @@ namespace Rocket
     template <typename T, typename... Arguments>
     constexpr Ref<T> CreateRef(Arguments ... args)
     {
+#if defined(USE_MEMORY_MANAGER)
+        // object and control block share one pooled allocation
+        Ref<T> ptr = std::allocate_shared<T>(PoolAllocator<T>(), args...);
+#else
         Ref<T> ptr = Ref<T>(
             new T(args...) //new (RK_ALLOCATE_CLASS(T)) T(args...)//, [](T* ptr) { RK_DELETE(T, ptr); }
         );
+#endif
         return std::move(ptr);
     }
 
     template <typename T, typename... Arguments>
 	constexpr Scope<T> CreateScope(Arguments ... args)
 	{
+#if defined(USE_MEMORY_MANAGER)
+        Scope<T> ptr = Scope<T>(
+            new (PoolAllocate(sizeof(T), alignof(T))) T(args...)
+        );
+#else
         Scope<T> ptr = Scope<T>(
             new T(args...) //new (RK_ALLOCATE_CLASS(T)) T(args...)//, [](T* ptr) { RK_DELETE(T, ptr); }
         );
+#endif
         return std::move(ptr);
 	}
 
@@ -70,4 +132,27 @@ namespace Rocket
 	using USet = std::unordered_set<T>;
 
 	using String = std::string;
+
+    // Containers bound to a std::pmr::memory_resource given at construction,
+    // e.g. a subsystem's PoolMemoryResource (Common/MemoryResource.h)
+    namespace pmr
+    {
+        template <typename T>
+        using Vec = std::pmr::vector<T>;
+
+        template <typename T1, typename T2>
+        using Map = std::pmr::map<T1, T2>;
+        template <typename T1, typename T2>
+        using UMap = std::pmr::unordered_map<T1, T2>;
+
+        template <typename T>
+        using List = std::pmr::list<T>;
+
+        template <typename T>
+        using Set = std::pmr::set<T>;
+        template <typename T>
+        using USet = std::pmr::unordered_set<T>;
+
+        using String = std::pmr::string;
+    }
 } // namespace Rocket
\ No newline at end of file
@@ -1,12 +1,5 @@
 #pragma once
 #include "Interface/IEvent.h"
 
-namespace Rocket
-{
-    class Event : implements IEvent
-    {
-    public:
-        Event(const EventVarPtr& var, uint32_t count) : IEvent(var, count) {}
-        virtual ~Event() = default;
-    };
-}
\ No newline at end of file
+// Event is a plain record defined in Interface/IEvent.h, this header is
+// kept for the modules that include it
@@ -0,0 +1,145 @@
+#pragma once
+#include "Core/Core.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory_resource>
+
+namespace Rocket
+{
+    // what every channel has regardless of its payload, lets EventManager
+    // keep channels of different types side by side
+    class EventChannelBase
+    {
+    public:
+        virtual ~EventChannelBase() = default;
+        // dispatch what was queued since the last update
+        virtual void Update() = 0;
+
+        // dense index of a payload type, assigned on first use
+        template<typename T>
+        static uint32_t TypeIndex()
+        {
+            static const uint32_t index = s_nTypeCount.fetch_add(1, std::memory_order_relaxed);
+            return index;
+        }
+
+    private:
+        inline static std::atomic<uint32_t> s_nTypeCount{0};
+    };
+
+    // Events of one plain struct type, e.g. WindowResize{Width, Height}.
+    // Listeners take the struct itself, no Variant to unpack and no type
+    // check. Each one is a function pointer to a thunk instantiated for the
+    // listener at compile time, so the call is direct and the listener can
+    // be inlined into it. Listeners and queued events sit in arrays.
+    // Listeners run in the order they connected, one returning true stops
+    // the rest. Main thread only, like the string id events
+    template<typename T>
+    class EventChannel final : public EventChannelBase
+    {
+    public:
+        explicit EventChannel(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : m_Listeners(resource), m_Queue{pmr::Vec<T>(resource), pmr::Vec<T>(resource)} {}
+
+        // bool Fn(const T&)
+        template<auto Fn>
+        void Connect() { m_Listeners.push_back({&CallFunction<Fn>, nullptr}); }
+        // bool (C::*Fn)(const T&)
+        template<auto Fn, typename C>
+        void Connect(C& instance) { m_Listeners.push_back({&CallMember<Fn, C>, &instance}); }
+
+        template<auto Fn>
+        bool Disconnect() { return Remove(&CallFunction<Fn>, nullptr); }
+        template<auto Fn, typename C>
+        bool Disconnect(C& instance) { return Remove(&CallMember<Fn, C>, &instance); }
+
+        bool Empty() const { return m_Listeners.empty(); }
+
+        // call the listeners now, true when one handled the event
+        bool Publish(const T& event)
+        {
+            // by index with the count taken up front, listeners connected
+            // meanwhile wait for the next event
+            bool processed = false;
+            ++m_nDispatchDepth;
+            size_t count = m_Listeners.size();
+            for (size_t i = 0; i < count; ++i)
+            {
+                Listener listener = m_Listeners[i];
+                // disconnected during dispatch
+                if (!listener.Call)
+                    continue;
+                processed = listener.Call(listener.Instance, event);
+                if (processed)
+                    break;
+            }
+            if (--m_nDispatchDepth == 0 && m_bDirty)
+                Compact();
+            return processed;
+        }
+
+        // hold the event for the next Update. Nobody listening, nothing kept
+        bool Queue(const T& event)
+        {
+            if (m_Listeners.empty())
+                return false;
+            m_Queue[m_nActive].push_back(event);
+            return true;
+        }
+
+        // events queued while it runs go to the next one
+        void Update() final
+        {
+            auto& queue = m_Queue[m_nActive];
+            m_nActive ^= 1;
+            for (size_t i = 0; i < queue.size(); ++i)
+                Publish(queue[i]);
+            // keeps its capacity
+            queue.clear();
+        }
+
+    private:
+        using CallFn = bool(*)(void*, const T&);
+
+        struct Listener
+        {
+            CallFn Call;
+            void*  Instance;
+        };
+
+        template<auto Fn>
+        static bool CallFunction(void*, const T& event) { return Fn(event); }
+        template<auto Fn, typename C>
+        static bool CallMember(void* instance, const T& event) { return (static_cast<C*>(instance)->*Fn)(event); }
+
+        bool Remove(CallFn call, void* instance)
+        {
+            for (auto& listener : m_Listeners)
+            {
+                if (listener.Call != call || listener.Instance != instance)
+                    continue;
+                // the dispatch loop goes by index, leave a hole until it is done
+                listener.Call = nullptr;
+                m_bDirty = true;
+                if (m_nDispatchDepth == 0)
+                    Compact();
+                return true;
+            }
+            return false;
+        }
+
+        void Compact()
+        {
+            m_Listeners.erase(std::remove_if(m_Listeners.begin(), m_Listeners.end(),
+                [](const Listener& listener) { return !listener.Call; }), m_Listeners.end());
+            m_bDirty = false;
+        }
+
+        pmr::Vec<Listener> m_Listeners;
+        pmr::Vec<T> m_Queue[2];
+        uint32_t m_nActive = 0;
+        uint32_t m_nDispatchDepth = 0;
+        bool     m_bDirty = false;
+    };
+}
@@ -0,0 +1,254 @@
+#include "Event/EventRecorder.h"
+
+#include <chrono>
+#include <cstring>
+
+using namespace Rocket;
+
+static const char kMagic[4] = {'R', 'K', 'E', 'V'};
+static const uint32_t kVersion = 1;
+// bytes encoded before the writer calls fwrite
+static const size_t kWriteBatch = 64 * 1024;
+
+// bytes a payload value takes in the log
+static size_t VariantSize(uint8_t type)
+{
+    switch (type)
+    {
+        case Variant::TYPE_INT32:
+        case Variant::TYPE_UINT32:
+        case Variant::TYPE_FLOAT: return 4;
+        case Variant::TYPE_BOOL: return 1;
+        default: return 8;
+    }
+}
+
+static void Encode(const EventRecord& record, Vec<uint8_t>& out)
+{
+    auto put = [&out](const void* data, size_t size) {
+        auto bytes = static_cast<const uint8_t*>(data);
+        out.insert(out.end(), bytes, bytes + size);
+    };
+
+    uint8_t kind = static_cast<uint8_t>(record.Kind);
+    put(&kind, 1);
+    put(&record.Data.TimeStamp, sizeof(double));
+    if (record.Kind == EventRecordKind::Frame)
+        return;
+
+    uint8_t count = static_cast<uint8_t>(record.Data.Count);
+    uint64_t type = record.Data.GetEventType();
+    put(&count, 1);
+    put(&type, sizeof(uint64_t));
+    for (uint32_t i = 1; i < record.Data.Count; ++i)
+    {
+        const Variant& var = record.Data.Var[i];
+        uint8_t var_type = static_cast<uint8_t>(var.type);
+        put(&var_type, 1);
+        // every union member starts at the union
+        put(&var.m_asStringId, VariantSize(var_type));
+    }
+}
+
+// false on a truncated or malformed record
+static bool Decode(const uint8_t*& data, const uint8_t* end, EventRecord& record)
+{
+    auto get = [&data, end](void* value, size_t size) {
+        if (static_cast<size_t>(end - data) < size)
+            return false;
+        std::memcpy(value, data, size);
+        data += size;
+        return true;
+    };
+
+    uint8_t kind;
+    double time_stamp;
+    if (!get(&kind, 1) || !get(&time_stamp, sizeof(double)))
+        return false;
+    record.Kind = static_cast<EventRecordKind>(kind);
+    if (record.Kind == EventRecordKind::Frame)
+    {
+        record.Data = Event();
+        record.Data.TimeStamp = time_stamp;
+        return true;
+    }
+
+    uint8_t count;
+    uint64_t type;
+    if (!get(&count, 1) || !get(&type, sizeof(uint64_t)) || count == 0 || count > Event::kMaxVars)
+        return false;
+    record.Data = Event(type);
+    record.Data.TimeStamp = time_stamp;
+    for (uint32_t i = 1; i < count; ++i)
+    {
+        uint8_t var_type;
+        if (!get(&var_type, 1) || var_type >= Variant::TYPE_COUNT)
+            return false;
+        Variant& var = record.Data.Var[i];
+        var.type = static_cast<Variant::Type>(var_type);
+        var.m_asStringId = 0;
+        if (!get(&var.m_asStringId, VariantSize(var_type)))
+            return false;
+    }
+    record.Data.Count = count;
+    return true;
+}
+
+bool EventRecorder::Start(const String& path)
+{
+    Stop();
+    m_pFile = fopen(path.c_str(), "wb");
+    if (!m_pFile)
+    {
+        RK_EVENT_ERROR("Open Event Record File {} Error", path);
+        return false;
+    }
+    fwrite(kMagic, 1, sizeof(kMagic), m_pFile);
+    fwrite(&kVersion, sizeof(kVersion), 1, m_pFile);
+
+    m_nRecords.store(0, std::memory_order_relaxed);
+    m_bRunning.store(true, std::memory_order_release);
+    m_Writer = std::thread([this]() { WriterLoop(); });
+    return true;
+}
+
+void EventRecorder::Stop()
+{
+    if (!m_pFile)
+        return;
+    m_bRunning.store(false, std::memory_order_release);
+    m_Writer.join();
+    fclose(m_pFile);
+    m_pFile = nullptr;
+}
+
+void EventRecorder::Record(const Event& event, EventRecordKind kind)
+{
+    m_Records.Push({event, kind});
+    m_nRecords.fetch_add(1, std::memory_order_relaxed);
+}
+
+void EventRecorder::RecordFrame(double time)
+{
+    EventRecord record;
+    record.Data.TimeStamp = time;
+    record.Kind = EventRecordKind::Frame;
+    m_Records.Push(record);
+    m_nRecords.fetch_add(1, std::memory_order_relaxed);
+}
+
+void EventRecorder::WriterLoop()
+{
+    Vec<uint8_t> buffer;
+    buffer.reserve(kWriteBatch + 64);
+    EventRecord record;
+    for (;;)
+    {
+        // records pushed before Stop are visible once it is seen
+        bool running = m_bRunning.load(std::memory_order_acquire);
+        bool wrote = false;
+        while (m_Records.Pop(record))
+        {
+            Encode(record, buffer);
+            if (buffer.size() >= kWriteBatch)
+            {
+                fwrite(buffer.data(), 1, buffer.size(), m_pFile);
+                buffer.clear();
+            }
+            wrote = true;
+        }
+        if (!buffer.empty())
+        {
+            fwrite(buffer.data(), 1, buffer.size(), m_pFile);
+            buffer.clear();
+        }
+        if (!running)
+            break;
+        if (!wrote)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    fflush(m_pFile);
+}
+
+bool EventReplayer::Open(const String& path, bool realtime)
+{
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file)
+    {
+        RK_EVENT_ERROR("Open Event Replay File {} Error", path);
+        return false;
+    }
+    Vec<uint8_t> bytes;
+    uint8_t chunk[4096];
+    size_t read;
+    while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0)
+        bytes.insert(bytes.end(), chunk, chunk + read);
+    fclose(file);
+
+    uint32_t version = 0;
+    if (bytes.size() < sizeof(kMagic) + sizeof(version) || std::memcmp(bytes.data(), kMagic, sizeof(kMagic)) != 0)
+    {
+        RK_EVENT_ERROR("{} Is Not An Event Record File", path);
+        return false;
+    }
+    std::memcpy(&version, bytes.data() + sizeof(kMagic), sizeof(version));
+    if (version != kVersion)
+    {
+        RK_EVENT_ERROR("Event Record File {} Version {} Not Supported", path, version);
+        return false;
+    }
+
+    // only frames and window input are fed back, the rest follows from them
+    m_Records.clear();
+    const uint8_t* data = bytes.data() + sizeof(kMagic) + sizeof(version);
+    const uint8_t* end = bytes.data() + bytes.size();
+    EventRecord record;
+    while (data < end)
+    {
+        if (!Decode(data, end, record))
+        {
+            RK_EVENT_WARN("Event Record File {} Truncated After {} Records", path, m_Records.size());
+            break;
+        }
+        if (record.Kind == EventRecordKind::Frame || record.Kind == EventRecordKind::Input)
+            m_Records.push_back(record);
+    }
+
+    m_nNext = 0;
+    m_nFrames = 0;
+    m_bRealtime = realtime;
+    m_bStarted = false;
+    return true;
+}
+
+bool EventReplayer::Poll(double now)
+{
+    if (m_nNext >= m_Records.size())
+        return false;
+
+    // record times are offsets from the first record
+    if (!m_bStarted)
+    {
+        m_bStarted = true;
+        m_StartTime = now - m_Records[m_nNext].Data.TimeStamp;
+    }
+
+    while (m_nNext < m_Records.size())
+    {
+        const EventRecord& record = m_Records[m_nNext];
+        if (m_bRealtime && record.Data.TimeStamp + m_StartTime > now)
+            break;
+        ++m_nNext;
+        if (record.Kind == EventRecordKind::Frame)
+        {
+            ++m_nFrames;
+            // as fast as possible: one recorded frame per poll
+            if (!m_bRealtime)
+                break;
+            continue;
+        }
+        Event event = record.Data;
+        m_Callback(event);
+    }
+    return m_nNext < m_Records.size();
+}
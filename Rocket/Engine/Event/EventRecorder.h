@@ -0,0 +1,84 @@
+#pragma once
+#include "Interface/IEvent.h"
+#include "Interface/IEventSource.h"
+#include "Utils/MPSCRingBuffer.h"
+
+#include <atomic>
+#include <cstdio>
+#include <thread>
+
+namespace Rocket
+{
+    // Binary event log, native byte order:
+    //   header  char[4] "RKEV", uint32 version
+    //   record  uint8 kind, double timestamp (ms)
+    //           events add: uint8 count, uint64 type, then count - 1 times
+    //           uint8 variant type + 8 bytes value
+    // Pointers in payloads are written as they are and mean nothing on replay
+    enum class EventRecordKind : uint8_t
+    {
+        Frame = 0,      // EventManager::Tick, separates the frames
+        Input,          // live input through OnEvent, what replay feeds back
+        Queued,
+        Triggered,
+    };
+
+    struct EventRecord
+    {
+        Event Data;
+        EventRecordKind Kind = EventRecordKind::Frame;
+    };
+
+    // Streams events to a file. Record only copies into a lock-free ring, a
+    // background thread encodes and writes
+    class EventRecorder
+    {
+    public:
+        EventRecorder() = default;
+        ~EventRecorder() { Stop(); }
+        // disable copy & assignment
+        EventRecorder(const EventRecorder& clone) = delete;
+        EventRecorder& operator=(const EventRecorder& rhs) = delete;
+
+        bool Start(const String& path);
+        // writes out what is left and closes the file
+        void Stop();
+        bool IsRecording() const { return m_pFile != nullptr; }
+
+        void Record(const Event& event, EventRecordKind kind);
+        void RecordFrame(double time);
+
+        uint64_t GetRecordCount() const { return m_nRecords.load(std::memory_order_relaxed); }
+
+    private:
+        void WriterLoop();
+
+        MPSCRingBuffer<EventRecord> m_Records{16384, RingOverflow::Spill};
+        FILE*       m_pFile = nullptr;
+        std::thread m_Writer;
+        std::atomic<bool> m_bRunning{false};
+        std::atomic<uint64_t> m_nRecords{0};
+    };
+
+    // Reads a log back and hands its input events out frame by frame, either
+    // at the pace they were recorded or one recorded frame per poll
+    class EventReplayer : implements IEventSource
+    {
+    public:
+        bool Open(const String& path, bool realtime);
+
+        // input events due at now go to the callback. False once the log is used up
+        bool Poll(double now) final;
+
+        bool IsRealtime() const { return m_bRealtime; }
+        size_t GetFrameCount() const { return m_nFrames; }
+
+    private:
+        Vec<EventRecord> m_Records;
+        size_t      m_nNext = 0;
+        size_t      m_nFrames = 0;
+        bool        m_bRealtime = true;
+        bool        m_bStarted = false;
+        double      m_StartTime = 0.0;     // replay time minus record time
+    };
+}
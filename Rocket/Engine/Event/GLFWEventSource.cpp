@@ -0,0 +1,125 @@
+#include "Event/GLFWEventSource.h"
+
+#include <GLFW/glfw3.h>
+
+using namespace Rocket;
+
+void GLFWEventSource::Emit(GLFWwindow* window, Event& event)
+{
+    auto source = static_cast<GLFWEventSource*>(glfwGetWindowUserPointer(window));
+    source->m_Callback(event);
+}
+
+void GLFWEventSource::Initialize(const EventCallbackFn& callback)
+{
+    IEventSource::Initialize(callback);
+    glfwSetWindowUserPointer(m_WindowHandle, this);
+
+    // Set GLFW callbacks
+	glfwSetWindowSizeCallback(m_WindowHandle, [](GLFWwindow *window, int width, int height) {
+		RK_EVENT_TRACE("glfwSetWindowSizeCallback");
+	});
+
+	glfwSetWindowContentScaleCallback(m_WindowHandle, [](GLFWwindow *window, float xscale, float yscale) {
+		RK_EVENT_TRACE("glfwSetWindowContentScaleCallback");
+	});
+
+	glfwSetWindowRefreshCallback(m_WindowHandle, [](GLFWwindow *window) {
+		RK_EVENT_TRACE("glfwSetWindowRefreshCallback");
+
+        Event event("window_refresh"_sid);
+        Emit(window, event);
+	});
+
+	glfwSetFramebufferSizeCallback(m_WindowHandle, [](GLFWwindow *window, int width, int height) {
+        RK_EVENT_TRACE("glfwSetFramebufferSizeCallback");
+
+        Event event("window_resize"_sid);
+        event.AddInt32(width).AddInt32(height).AddInt32(0);
+		Emit(window, event);
+	});
+
+	glfwSetWindowCloseCallback(m_WindowHandle, [](GLFWwindow *window) {
+        RK_EVENT_TRACE("glfwSetWindowCloseCallback");
+
+        Event event("window_close"_sid);
+        Emit(window, event);
+	});
+
+	glfwSetKeyCallback(m_WindowHandle, [](GLFWwindow *window, int key, int scancode, int action, int mods) {
+        //RK_EVENT_TRACE("glfwSetKeyCallback");
+
+        EventType type = 0;
+        int32_t repeat = 0;
+		switch (action)
+		{
+            case GLFW_PRESS: {
+                type = "key_press"_sid;
+            } break;
+            case GLFW_RELEASE: {
+                type = "key_release"_sid;
+            } break;
+            case GLFW_REPEAT: {
+                type = "key_repeat"_sid;
+                repeat = 1;
+            } break;
+		}
+        Event event(type);
+        event.AddInt32(scancode).AddInt32(repeat);
+        Emit(window, event);
+	});
+
+	glfwSetCharCallback(m_WindowHandle, [](GLFWwindow *window, uint32_t keycode) {
+        //RK_EVENT_TRACE("glfwSetCharCallback");
+
+        Event event("key_char_code"_sid);
+        event.AddUInt32(keycode);
+        Emit(window, event);
+	});
+
+	glfwSetMouseButtonCallback(m_WindowHandle, [](GLFWwindow *window, int button, int action, int mods) {
+        //RK_EVENT_TRACE("glfwSetMouseButtonCallback");
+
+        EventType type = 0;
+		switch (action)
+		{
+            case GLFW_PRESS: {
+                type = "mouse_button_press"_sid;
+            } break;
+            case GLFW_RELEASE: {
+                type = "mouse_button_release"_sid;
+            } break;
+		}
+
+        Event event(type);
+        event.AddInt32(button);
+        Emit(window, event);
+	});
+
+	glfwSetScrollCallback(m_WindowHandle, [](GLFWwindow *window, double xOffset, double yOffset) {
+        //RK_EVENT_TRACE("glfwSetScrollCallback");
+
+        Event event("mouse_scroll"_sid);
+        event.AddDouble(xOffset).AddDouble(yOffset);
+        Emit(window, event);
+	});
+
+	glfwSetCursorPosCallback(m_WindowHandle, [](GLFWwindow *window, double xPos, double yPos) {
+        //RK_EVENT_TRACE("glfwSetCursorPosCallback");
+
+        Event event("mouse_move"_sid);
+        event.AddDouble(xPos).AddDouble(yPos);
+		Emit(window, event);
+	});
+}
+
+void GLFWEventSource::Finalize()
+{
+    glfwSetWindowUserPointer(m_WindowHandle, nullptr);
+}
+
+bool GLFWEventSource::Poll(double now)
+{
+    glfwPollEvents();
+    return true;
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include "Interface/IEventSource.h"
+
+struct GLFWwindow;
+
+namespace Rocket
+{
+    // Input of a GLFW window, turned into events by the window callbacks
+    // while Poll runs glfwPollEvents
+    class GLFWEventSource : implements IEventSource
+    {
+    public:
+        explicit GLFWEventSource(GLFWwindow* window) : m_WindowHandle(window) {}
+        virtual ~GLFWEventSource() = default;
+
+        void Initialize(const EventCallbackFn& callback) final;
+        void Finalize() final;
+
+        bool Poll(double now) final;
+
+    private:
+        static void Emit(GLFWwindow* window, Event& event);
+
+        GLFWwindow* m_WindowHandle = nullptr;
+    };
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include "Interface/IEvent.h"
+
+// Typed forms of the window input events, for EventChannel listeners.
+// kType names the string id event each one is made from, FromEvent reads
+// the payload the event sources write, in the same order
+namespace Rocket
+{
+    struct WindowClose
+    {
+        static constexpr EventType kType = "window_close"_sid;
+        static WindowClose FromEvent(const Event& event) { return {}; }
+    };
+
+    struct WindowResize
+    {
+        static constexpr EventType kType = "window_resize"_sid;
+        static WindowResize FromEvent(const Event& event) { return {event.Var[1].m_asInt32, event.Var[2].m_asInt32}; }
+
+        int32_t Width;
+        int32_t Height;
+    };
+
+    struct KeyPress
+    {
+        static constexpr EventType kType = "key_press"_sid;
+        static KeyPress FromEvent(const Event& event) { return {event.Var[1].m_asInt32}; }
+
+        int32_t Scancode;
+    };
+
+    struct KeyRelease
+    {
+        static constexpr EventType kType = "key_release"_sid;
+        static KeyRelease FromEvent(const Event& event) { return {event.Var[1].m_asInt32}; }
+
+        int32_t Scancode;
+    };
+
+    struct MouseButtonPress
+    {
+        static constexpr EventType kType = "mouse_button_press"_sid;
+        static MouseButtonPress FromEvent(const Event& event) { return {event.Var[1].m_asInt32}; }
+
+        int32_t Button;
+    };
+
+    struct MouseButtonRelease
+    {
+        static constexpr EventType kType = "mouse_button_release"_sid;
+        static MouseButtonRelease FromEvent(const Event& event) { return {event.Var[1].m_asInt32}; }
+
+        int32_t Button;
+    };
+
+    struct MouseMove
+    {
+        static constexpr EventType kType = "mouse_move"_sid;
+        static MouseMove FromEvent(const Event& event) { return {event.Var[1].m_asDouble, event.Var[2].m_asDouble}; }
+
+        double X;
+        double Y;
+    };
+
+    struct MouseScroll
+    {
+        static constexpr EventType kType = "mouse_scroll"_sid;
+        static MouseScroll FromEvent(const Event& event) { return {event.Var[1].m_asDouble, event.Var[2].m_asDouble}; }
+
+        double OffsetX;
+        double OffsetY;
+    };
+}
@@ -0,0 +1,51 @@
+#include "Event/SyntheticEventSource.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Rocket;
+
+// out of every eight events: five cursor moves, a scroll, a press and its release
+static const uint32_t kPatternLength = 8;
+// cursor steps per turn around the circle
+static const double kCircleSteps = 360.0;
+// M_PI needs _USE_MATH_DEFINES on MSVC before anything includes <cmath>
+static const double kPi = 3.14159265358979323846;
+
+bool SyntheticEventSource::Poll(double now)
+{
+    if (m_nFrames != 0 && m_nFrame >= m_nFrames)
+        return false;
+
+    double center_x = m_nWidth * 0.5;
+    double center_y = m_nHeight * 0.5;
+    double radius = std::min(m_nWidth, m_nHeight) * 0.25;
+    for (uint32_t i = 0; i < m_nEventsPerFrame; ++i, ++m_nSequence)
+    {
+        uint32_t step = static_cast<uint32_t>(m_nSequence % kPatternLength);
+        // keys cycle through the letter scancodes
+        int32_t scancode = 30 + static_cast<int32_t>((m_nSequence / kPatternLength) % 26);
+        if (step < 5)
+        {
+            double angle = 2.0 * kPi * static_cast<double>(m_nSequence % 360) / kCircleSteps;
+            Event event("mouse_move"_sid);
+            event.AddDouble(center_x + radius * std::cos(angle)).AddDouble(center_y + radius * std::sin(angle));
+            m_Callback(event);
+        }
+        else if (step == 5)
+        {
+            Event event("mouse_scroll"_sid);
+            event.AddDouble(0.0).AddDouble(1.0);
+            m_Callback(event);
+        }
+        else
+        {
+            Event event(step == 6 ? "key_press"_sid : "key_release"_sid);
+            event.AddInt32(scancode).AddInt32(0);
+            m_Callback(event);
+        }
+    }
+
+    ++m_nFrame;
+    return m_nFrames == 0 || m_nFrame < m_nFrames;
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include "Interface/IEventSource.h"
+
+namespace Rocket
+{
+    // Made up input for runs without a display or a recording: every frame
+    // a fixed mix of cursor moves along a circle, scrolls and key presses
+    // and releases. The same settings give the same events every run
+    class SyntheticEventSource : implements IEventSource
+    {
+    public:
+        // frames zero keeps going until the source is removed
+        SyntheticEventSource(uint32_t events_per_frame, uint32_t frames, uint32_t width, uint32_t height)
+            : m_nEventsPerFrame(events_per_frame), m_nFrames(frames), m_nWidth(width), m_nHeight(height) {}
+        virtual ~SyntheticEventSource() = default;
+
+        bool Poll(double now) final;
+
+        uint32_t GetFrameCount() const { return m_nFrame; }
+
+    private:
+        uint32_t m_nEventsPerFrame;
+        uint32_t m_nFrames;
+        uint32_t m_nWidth;
+        uint32_t m_nHeight;
+        uint32_t m_nFrame = 0;
+        uint64_t m_nSequence = 0;
+    };
+}
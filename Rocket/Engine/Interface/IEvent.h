@@ -8,71 +8,97 @@
 #include <optional>
 #include <functional>
 #include <sstream>
+#include <type_traits>
 
 namespace Rocket
 {
-	using EventVarPtr = Ref<Variant>;
 	using EventType = uint64_t;
 
 	extern ElapseTimer* g_EventTimer;
 
-	Interface IEvent
+	// Fixed size, trivially copyable event, queued by value so posting an
+	// event never allocates. Var[0] holds the event type as a string id,
+	// the payload follows in Var[1..Count).
+	struct Event
 	{
-	public:
-		IEvent(const EventVarPtr& var, uint32_t count) : Var(var), Count(count)
-		{
-			RK_CORE_ASSERT(count > 0, "Event Var Count Error");
-			TimeStamp = g_EventTimer->GetExactTime();
-		}
-		virtual ~IEvent() 
+		static constexpr uint32_t kMaxVars = 4;
+
+		Event() = default;
+		explicit Event(EventType type) : Count(1)
 		{
-			//delete[] Var;
+			Var[0].type = Variant::TYPE_STRING_ID;
+			Var[0].m_asStringId = type;
+			TimeStamp = g_EventTimer ? g_EventTimer->GetExactTime() : 0.0;
 		}
 
-		[[nodiscard]] virtual EventType GetEventType() const { return Var.get()[0].m_asStringId; }
-		[[nodiscard]] virtual const String& GetName() const { return EventHashTable::GetStringFromId(GetEventType()); }
-		[[nodiscard]] virtual const String& ToString() const { return GetName(); }
+		[[nodiscard]] EventType GetEventType() const { return Var[0].m_asStringId; }
+		[[nodiscard]] const String& GetName() const { return EventHashTable::GetStringFromId(GetEventType()); }
+		[[nodiscard]] const String& ToString() const { return GetName(); }
+
+		[[nodiscard]] int32_t GetInt32(uint32_t index) const { RK_CORE_ASSERT(index < Count, "event index error"); return Var[index].m_asInt32; }
+		[[nodiscard]] uint32_t GetUInt32(uint32_t index) const { RK_CORE_ASSERT(index < Count, "event index error"); return Var[index].m_asUInt32; }
+		[[nodiscard]] float GetFloat(uint32_t index) const { RK_CORE_ASSERT(index < Count, "event index error"); return Var[index].m_asFloat; }
+		[[nodiscard]] double GetDouble(uint32_t index) const { RK_CORE_ASSERT(index < Count, "event index error"); return Var[index].m_asDouble; }
+		[[nodiscard]] bool GetBool(uint32_t index) const { RK_CORE_ASSERT(index < Count, "event index error"); return Var[index].m_asBool; }
+		[[nodiscard]] void* GetPointer(uint32_t index) const { RK_CORE_ASSERT(index < Count, "event index error"); return Var[index].m_asPointer; }
+		[[nodiscard]] string_id GetStringId(uint32_t index) const { RK_CORE_ASSERT(index < Count, "event index error"); return Var[index].m_asStringId; }
 
-		[[nodiscard]] int32_t GetInt32(uint32_t index) { RK_CORE_ASSERT(index < Count, "event index error"); return Var.get()[index].m_asInt32; }
-		[[nodiscard]] uint32_t GetUInt32(uint32_t index) { RK_CORE_ASSERT(index < Count, "event index error"); return Var.get()[index].m_asUInt32; }
-		[[nodiscard]] float GetFloat(uint32_t index) { RK_CORE_ASSERT(index < Count, "event index error"); return Var.get()[index].m_asFloat; }
-		[[nodiscard]] double GetDouble(uint32_t index) { RK_CORE_ASSERT(index < Count, "event index error"); return Var.get()[index].m_asDouble; }
-		[[nodiscard]] bool GetBool(uint32_t index) { RK_CORE_ASSERT(index < Count, "event index error"); return Var.get()[index].m_asBool; }
-		[[nodiscard]] void* GetPointer(uint32_t index) { RK_CORE_ASSERT(index < Count, "event index error"); return Var.get()[index].m_asPointer; }
-		[[nodiscard]] string_id GetStringId(uint32_t index) { RK_CORE_ASSERT(index < Count, "event index error"); return Var.get()[index].m_asStringId; }
+		// append payload values, up to kMaxVars - 1 of them
+		Event& AddInt32(int32_t value) { Next(Variant::TYPE_INT32).m_asInt32 = value; return *this; }
+		Event& AddUInt32(uint32_t value) { Next(Variant::TYPE_UINT32).m_asUInt32 = value; return *this; }
+		Event& AddFloat(float value) { Next(Variant::TYPE_FLOAT).m_asFloat = value; return *this; }
+		Event& AddDouble(double value) { Next(Variant::TYPE_DOUBLE).m_asDouble = value; return *this; }
+		Event& AddBool(bool value) { Next(Variant::TYPE_BOOL).m_asBool = value; return *this; }
+		Event& AddPointer(void* value) { Next(Variant::TYPE_POINTER).m_asPointer = value; return *this; }
+		Event& AddStringId(string_id value) { Next(Variant::TYPE_STRING_ID).m_asStringId = value; return *this; }
 
+		double TimeStamp = 0.0;
+		uint32_t Count = 0;
 		bool Handled = false;
-		double TimeStamp = 0.0f;
-		EventVarPtr Var;
-		uint32_t Count;
+		Variant Var[kMaxVars];
+
+	private:
+		Variant& Next(Variant::Type type)
+		{
+			RK_CORE_ASSERT(Count < kMaxVars, "event payload full");
+			Variant& var = Var[Count++];
+			var.type = type;
+			return var;
+		}
 	};
+	static_assert(std::is_trivially_copyable_v<Event>, "Event is copied around by value");
 
-	using EventPtr = Ref<IEvent>;
+	// Listeners get a pointer to the event being dispatched, it is only
+	// valid during the call; copy *event to keep it
+	using EventPtr = Event*;
 
-	inline std::ostream& operator<<(std::ostream& os, const IEvent &e)
+	inline std::ostream& operator<<(std::ostream& os, const Event& e)
 	{
 		os << e.ToString();
-		for (uint32_t i = 0; i < e.Count; ++i)
+		for (uint32_t i = 1; i < e.Count; ++i)
 		{
-			switch (e.Var.get()[i].type)
+			switch (e.Var[i].type)
 			{
 			case Variant::TYPE_INT32:
-				os << "[" << e.Var.get()[i].m_asInt32 << "]";
+				os << "[" << e.Var[i].m_asInt32 << "]";
 				break;
 			case Variant::TYPE_UINT32:
-				os << "[" << e.Var.get()[i].m_asUInt32 << "]";
+				os << "[" << e.Var[i].m_asUInt32 << "]";
 				break;
 			case Variant::TYPE_FLOAT:
-				os << "[" << e.Var.get()[i].m_asFloat << "]";
+				os << "[" << e.Var[i].m_asFloat << "]";
 				break;
 			case Variant::TYPE_DOUBLE:
-				os << "[" << e.Var.get()[i].m_asDouble << "]";
+				os << "[" << e.Var[i].m_asDouble << "]";
+				break;
+			case Variant::TYPE_BOOL:
+				os << "[" << e.Var[i].m_asBool << "]";
 				break;
 			case Variant::TYPE_POINTER:
-				os << "[" << e.Var.get()[i].m_asPointer << "]";
+				os << "[" << e.Var[i].m_asPointer << "]";
 				break;
 			case Variant::TYPE_STRING_ID:
-				os << "[" << e.Var.get()[i].m_asStringId << "]";
+				os << "[" << e.Var[i].m_asStringId << "]";
 				break;
 			default:
 				RK_EVENT_ERROR("Unknow Event Data Type");
@@ -0,0 +1,29 @@
+#pragma once
+#include "Core/Core.h"
+#include "Interface/IEvent.h"
+
+#include <functional>
+
+namespace Rocket
+{
+    using EventCallbackFn = std::function<void(Event&)>;
+
+    // Where input comes from: the window, a recording or a generator.
+    // EventManager polls its sources once per frame before it updates
+    Interface IEventSource
+    {
+    public:
+        virtual ~IEventSource() = default;
+
+        // input goes to callback from now on
+        virtual void Initialize(const EventCallbackFn& callback) { m_Callback = callback; }
+        virtual void Finalize() {}
+
+        // hand out the input due at now, g_EventTimer time in milliseconds.
+        // False once the source will not produce anything more
+        virtual bool Poll(double now) = 0;
+
+    protected:
+        EventCallbackFn m_Callback;
+    };
+}
@@ -9,7 +9,8 @@ namespace Rocket
         IMemoryManager() = default;
         virtual ~IMemoryManager() = default;
 
-        virtual void* AllocatePage(size_t size) = 0;
+        // owner tags the page, e.g. with the size class it is carved into
+        virtual void* AllocatePage(size_t size, uint16_t owner) = 0;
         virtual void FreePage(void* p) = 0;
     };
 }
\ No newline at end of file
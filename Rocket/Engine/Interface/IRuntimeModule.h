@@ -1,9 +1,31 @@
 #pragma once
 #include "Core/Core.h"
+#include "Utils/Hashing.h"
 #include "Utils/Timestep.h"
 
 namespace Rocket
 {
+    // What a module's Tick touches, so the application can tick modules
+    // side by side. Resources are string ids, e.g. "scene"_sid. A module
+    // ticks after the earlier pushed ones writing what it reads or writes,
+    // or reading what it writes. Left untouched the module is exclusive:
+    // it ticks alone, after every module pushed before it
+    struct ModuleTickAccess
+    {
+        ModuleTickAccess& Read(uint64_t resource) { Reads.push_back(resource); Exclusive = false; return *this; }
+        ModuleTickAccess& Write(uint64_t resource) { Writes.push_back(resource); Exclusive = false; return *this; }
+        // no resources at all, ticks alongside anything
+        ModuleTickAccess& Independent() { Exclusive = false; return *this; }
+        // may tick on a job worker. Such a module posts events through
+        // EventManager::ThreadSafeQueueEvent only
+        ModuleTickAccess& AnyThread() { MainThread = false; return *this; }
+
+        Vec<uint64_t> Reads;
+        Vec<uint64_t> Writes;
+        bool Exclusive = true;
+        bool MainThread = true;
+    };
+
     Interface IRuntimeModule
     {
     public:
@@ -14,6 +36,8 @@ namespace Rocket
         virtual void Finalize() = 0;
 
         virtual void Tick(Timestep ts) = 0;
+        // see ModuleTickAccess, asked once the modules are initialized
+        virtual void DeclareTickAccess(ModuleTickAccess& access) const {}
 
         // For Debug
         [[nodiscard]] virtual const char* GetName() const = 0;
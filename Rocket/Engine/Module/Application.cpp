@@ -10,6 +10,8 @@ void Application::LoadConfig(const Ref<ConfigLoader>& config)
     m_Config = config;
     m_AssetPath = config->GetAssetPath();
     RK_CORE_INFO("Asset Path {0}", m_AssetPath);
+    if (config->HasConfigInfo("Job", "parallel_tick"))
+        m_Parallel = config->GetConfigInfo<bool>("Job", "parallel_tick");
 }
 
 int Application::InitializeModule()
@@ -24,11 +26,25 @@ int Application::InitializeModule()
             return ret;
         }
     }
+    BuildModuleGraph();
     return ret;
 }
 
 void Application::FinalizeModule()
 {
+    if (m_nTickedFrames > 0)
+    {
+        double serial = 0.0;
+        for (size_t i = 0; i < m_Modules.size(); ++i)
+        {
+            double average = m_ModuleTickTotals[i] / m_nTickedFrames;
+            serial += average;
+            RK_CORE_INFO("Module {0} Tick {1} ms", m_Modules[i]->GetName(), average);
+        }
+        RK_CORE_INFO("Module Tick Critical Path {0} ms, Serial {1} ms, {2} Frames",
+            m_CriticalPathTotal / m_nTickedFrames, serial, m_nTickedFrames);
+    }
+
     for (auto iter = m_Modules.rbegin(); iter != m_Modules.rend(); iter++)
     {
         RK_CORE_INFO("Finalize Module {0}", (*iter)->GetName());
@@ -53,18 +69,146 @@ void Application::Finalize()
 void Application::PushModule(IRuntimeModule* module)
 {
     m_Modules.emplace_back(module);
+    m_bModuleGraphDirty = true;
+}
+
+static bool Overlaps(const Vec<uint64_t>& lhs, const Vec<uint64_t>& rhs)
+{
+    for (auto resource : lhs)
+    {
+        if (std::find(rhs.begin(), rhs.end(), resource) != rhs.end())
+            return true;
+    }
+    return false;
+}
+
+// Edges only run from earlier to later pushed modules, so push order stays
+// a valid order and the graph has no cycles. Modules and what they declare
+// do not change from frame to frame, the graph is built once
+void Application::BuildModuleGraph()
+{
+    uint32_t count = static_cast<uint32_t>(m_Modules.size());
+    m_ModuleGraph.clear();
+    m_ModuleGraph.resize(count);
+    for (uint32_t i = 0; i < count; ++i)
+        m_Modules[i]->DeclareTickAccess(m_ModuleGraph[i].Access);
+
+    for (uint32_t j = 0; j < count; ++j)
+    {
+        const auto& later = m_ModuleGraph[j].Access;
+        for (uint32_t i = 0; i < j; ++i)
+        {
+            const auto& earlier = m_ModuleGraph[i].Access;
+            bool depends = earlier.Exclusive || later.Exclusive ||
+                Overlaps(earlier.Writes, later.Reads) ||
+                Overlaps(earlier.Writes, later.Writes) ||
+                Overlaps(earlier.Reads, later.Writes);
+            if (!depends)
+                continue;
+            m_ModuleGraph[i].Next.push_back(j);
+            m_ModuleGraph[j].Prev.push_back(i);
+        }
+    }
+
+    m_ModulesPending.reset(new std::atomic<uint32_t>[count]);
+    m_ModuleTickTimes.assign(count, 0.0);
+    m_ModuleTickTotals.assign(count, 0.0);
+    m_ModuleFinishTimes.assign(count, 0.0);
+    m_CriticalPathTotal = 0.0;
+    m_nTickedFrames = 0;
+    m_bModuleGraphDirty = false;
 }
 
 void Application::Tick(Timestep ts)
 {
 	PROFILE_BEGIN_CPU_SAMPLE(ModuleUpdate, 0);
-    for (auto &module : m_Modules)
+    if (m_bModuleGraphDirty)
+        BuildModuleGraph();
+
+    if (m_Parallel && m_pJobSystem)
+        TickModulesParallel(ts);
+    else
+        TickModulesSerial(ts);
+
+    // longest chain of ticks through the graph, push order is topological
+    m_CriticalPathTime = 0.0;
+    Vec<double>& finish = m_ModuleFinishTimes;
+    for (size_t i = 0; i < m_Modules.size(); ++i)
     {
-        module->Tick(ts);
+        double start = 0.0;
+        for (auto prev : m_ModuleGraph[i].Prev)
+            start = std::max(start, finish[prev]);
+        finish[i] = start + m_ModuleTickTimes[i];
+        m_CriticalPathTime = std::max(m_CriticalPathTime, finish[i]);
+        m_ModuleTickTotals[i] += m_ModuleTickTimes[i];
     }
+    m_CriticalPathTotal += m_CriticalPathTime;
+    ++m_nTickedFrames;
 	PROFILE_END_CPU_SAMPLE();
 }
 
+void Application::TickModulesSerial(Timestep ts)
+{
+    ElapseTimer timer;
+    for (size_t i = 0; i < m_Modules.size(); ++i)
+    {
+        timer.Start();
+        m_Modules[i]->Tick(ts);
+        m_ModuleTickTimes[i] = timer.Stop();
+    }
+}
+
+void Application::TickModulesParallel(Timestep ts)
+{
+    uint32_t count = static_cast<uint32_t>(m_Modules.size());
+    if (count == 0)
+        return;
+    for (uint32_t i = 0; i < count; ++i)
+        m_ModulesPending[i].store(static_cast<uint32_t>(m_ModuleGraph[i].Prev.size()), std::memory_order_relaxed);
+    m_nModulesLeft.store(count, std::memory_order_relaxed);
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (m_ModuleGraph[i].Prev.empty())
+            LaunchModule(i, ts);
+    }
+
+    // main thread modules are ticked here, in between it helps the workers
+    while (m_nModulesLeft.load(std::memory_order_acquire) > 0)
+    {
+        uint32_t index;
+        if (m_MainThreadModules.TryPop(index))
+            RunModule(index, ts);
+        else if (!m_pJobSystem->RunPendingJob())
+            std::this_thread::yield();
+    }
+    // the last module jobs may still be returning
+    m_pJobSystem->Wait(m_ModuleJobs);
+}
+
+void Application::LaunchModule(uint32_t index, Timestep ts)
+{
+    if (m_ModuleGraph[index].Access.MainThread)
+        m_MainThreadModules.Push(index);
+    else
+        m_pJobSystem->Run(m_ModuleJobs, [this, index, ts]() { RunModule(index, ts); });
+}
+
+void Application::RunModule(uint32_t index, Timestep ts)
+{
+    ElapseTimer timer;
+    timer.Start();
+    m_Modules[index]->Tick(ts);
+    m_ModuleTickTimes[index] = timer.Stop();
+
+    for (auto next : m_ModuleGraph[index].Next)
+    {
+        if (m_ModulesPending[next].fetch_sub(1, std::memory_order_acq_rel) == 1)
+            LaunchModule(next, ts);
+    }
+    m_nModulesLeft.fetch_sub(1, std::memory_order_release);
+}
+
 bool Application::OnWindowClose(EventPtr& e)
 {
     RK_CORE_TRACE("Application::OnWindowClose");
@@ -1,6 +1,10 @@
 #pragma once
 #include "Interface/IApplication.h"
 #include "Interface/IEvent.h"
+#include "Utils/JobSystem.h"
+#include "Utils/MPSCRingBuffer.h"
+
+#include <memory>
 
 namespace Rocket
 {
@@ -24,9 +28,16 @@ namespace Rocket
         virtual void FinalizeModule() final;
 
         void PushModule(IRuntimeModule* module);
+        // ticks modules side by side when m_Parallel is set, see ModuleTickAccess
+        void SetJobSystem(JobSystem* jobs) { m_pJobSystem = jobs; }
 
         virtual void Tick(Timestep ts) final;
 
+        // last frame, in milliseconds: each module's tick in push order, and
+        // the longest chain of ticks that had to run one after another
+        const Vec<double>& GetModuleTickTimes() const { return m_ModuleTickTimes; }
+        double GetCriticalPathTime() const { return m_CriticalPathTime; }
+
         static Application& Get() { return *s_Instance; }
 
         // Event Call Back
@@ -44,6 +55,38 @@ namespace Rocket
         String m_AssetPath;
         
     private:
+        struct ModuleNode
+        {
+            ModuleTickAccess Access;
+            Vec<uint32_t> Prev;     // modules ticking before it
+            Vec<uint32_t> Next;
+        };
+
+        void BuildModuleGraph();
+        void TickModulesSerial(Timestep ts);
+        void TickModulesParallel(Timestep ts);
+        void LaunchModule(uint32_t index, Timestep ts);
+        void RunModule(uint32_t index, Timestep ts);
+
+        // dependency graph of m_Modules, rebuilt when a module is pushed
+        Vec<ModuleNode> m_ModuleGraph;
+        bool m_bModuleGraphDirty = true;
+        JobSystem* m_pJobSystem = nullptr;
+        // per frame: predecessors still ticking, modules not done yet
+        std::unique_ptr<std::atomic<uint32_t>[]> m_ModulesPending;
+        std::atomic<uint32_t> m_nModulesLeft{0};
+        // ready modules that must tick on the main thread
+        MPSCRingBuffer<uint32_t> m_MainThreadModules{64, RingOverflow::Spill};
+        JobCounter m_ModuleJobs;
+
+        Vec<double> m_ModuleTickTimes;
+        Vec<double> m_ModuleTickTotals;
+        // when each module finished on the critical path, sized with the graph
+        Vec<double> m_ModuleFinishTimes;
+        double m_CriticalPathTime = 0.0;
+        double m_CriticalPathTotal = 0.0;
+        uint64_t m_nTickedFrames = 0;
+
         static Application* s_Instance;
     };
 
@@ -12,6 +12,15 @@ using namespace Rocket;
 
 AssetLoader* Rocket::GetAssetLoader() { return new AssetLoader(); }
 
+// files read at this size and up get pages of their own, given back to the
+// OS as soon as the last slice dies instead of staying in the heap
+static const size_t kMappedReadSize = 256 * 1024;
+
+static IBufferAllocator* ReadBufferAllocator(size_t size)
+{
+    return size >= kMappedReadSize ? MappedBufferAllocator::Get() : nullptr;
+}
+
 int AssetLoader::Initialize()
 {
     auto config = g_Application->GetConfig();
@@ -33,7 +42,7 @@ AssetFilePtr AssetLoader::SyncOpenAndReadTexture(const String& filePath, int32_t
 
     stbi_set_flip_vertically_on_load(1);
 	stbi_uc* data = nullptr;
-    data = stbi_load_from_memory(buffer.GetData().get(), buffer.GetDataSize(), width, height, channels, desired_channel);
+    data = stbi_load_from_memory(buffer.GetPointer(), static_cast<int>(buffer.GetDataSize()), width, height, channels, desired_channel);
 	RK_CORE_TRACE("Texture Info : width {}, height {}, channels {}", *width, *height, *channels);
     RK_CORE_ASSERT(data, "Failed to load image!");
     return data;
@@ -53,7 +62,7 @@ Vec<AssetFilePtr> AssetLoader::SyncOpenAndReadTextureCube(const Vec<String>& fil
 
         stbi_set_flip_vertically_on_load(1);
         stbi_uc* data = nullptr;
-        data = stbi_load_from_memory(buffer.GetData().get(), buffer.GetDataSize(), width, height, channels, desired_channel);
+        data = stbi_load_from_memory(buffer.GetPointer(), static_cast<int>(buffer.GetDataSize()), width, height, channels, desired_channel);
         RK_CORE_TRACE("Texture Info : width {}, height {}, channels {}", *width, *height, *channels);
         RK_CORE_ASSERT(data, "Failed to load image!");
         result.push_back(data);
@@ -72,7 +81,9 @@ void AssetLoader::SyncCloseTextureCube(Vec<AssetFilePtr>& datas)
 Texture2DAsset AssetLoader::SyncLoadTexture2D(const String& filename)
 {
     String fullPath = m_AssetPath + filename;
-    auto data = gli::load(fullPath.c_str());
+    // parse from the mapped file instead of gli reading it into a vector
+    Buffer file = Buffer::MapFile(fullPath);
+    auto data = file.Empty() ? gli::load(fullPath.c_str()) : gli::load(reinterpret_cast<const char*>(file.GetPointer()), file.GetDataSize());
     RK_CORE_TRACE("Open Texture 2D {}, {}, {}", fullPath, data.size(), data.levels());
     Texture2DAsset pic(data);
     RK_CORE_TRACE("Create Texture 2D {}", fullPath);
@@ -82,7 +93,8 @@ Texture2DAsset AssetLoader::SyncLoadTexture2D(const String& filename)
 TextureCubeAsset AssetLoader::SyncLoadTextureCube(const String& filename)
 {
     String fullPath = m_AssetPath + filename;
-    auto data = gli::load(fullPath.c_str());
+    Buffer file = Buffer::MapFile(fullPath);
+    auto data = file.Empty() ? gli::load(fullPath.c_str()) : gli::load(reinterpret_cast<const char*>(file.GetPointer()), file.GetDataSize());
     RK_CORE_TRACE("Open Texture Cube {}", fullPath);
     TextureCubeAsset pic(data);
     RK_CORE_TRACE("Create Texture Cube {}", fullPath);
@@ -198,11 +210,8 @@ String AssetLoader::SyncOpenAndReadTextFileToString(const String& fileName)
 
 bool AssetLoader::SyncOpenAndWriteStringToTextFile(const String& fileName, const String& content)
 {
-    Buffer buf;
-    size_t sz = content.size();
-    Ref<uint8_t> data = Ref<uint8_t>(new uint8_t[sz + 1], [](uint8_t* v){ delete[]v; });
-    memcpy(data.get(), content.data(), sz);
-    data.get()[sz] = '\0';
+    // c_str() is terminated, the text writer can use it in place
+    Buffer buf = Buffer::Wrap(content.c_str(), content.size());
     bool result = SyncOpenAndWriteText(fileName, buf);
     return result;
 }
@@ -249,13 +258,14 @@ Buffer AssetLoader::SyncOpenAndReadText(const String& filePath)
     {
         size_t length = GetSize(fp);
 
-        Ref<uint8_t> data = Ref<uint8_t>(new uint8_t[length + 1], [](uint8_t* v){ delete[]v; });
-        length = fread(data.get(), 1, length, static_cast<FILE*>(fp));
+        // text needs a terminator, so it is read rather than mapped
+        Buffer data(length + 1, 1, ReadBufferAllocator(length + 1));
+        length = fread(data.GetPointer(), 1, length, static_cast<FILE*>(fp));
 #ifdef RK_DEBUG
         RK_CORE_TRACE("Read file '{}', {} bytes", filePath, length);
 #endif
-        data.get()[length] = '\0';
-        buff.SetData(data, length);
+        data.GetPointer()[length] = '\0';
+        buff = data.Slice(0, length);
 
         CloseFile(fp);
     }
@@ -267,19 +277,31 @@ Buffer AssetLoader::SyncOpenAndReadText(const String& filePath)
 
 Buffer AssetLoader::SyncOpenAndReadBinary(const String& filePath)
 {
-    AssetFilePtr fp = OpenFile(filePath, AssetOpenMode::RK_OPEN_BINARY);
-    Buffer buff;
+    // map the file so decoders read straight from the page cache
+    String fullPath = m_AssetPath + filePath;
+    Buffer buff = Buffer::MapFile(fullPath);
+    if (!buff.Empty())
+    {
+#ifdef RK_DEBUG
+        RK_CORE_TRACE("Map file '{}', {} bytes", filePath, buff.GetDataSize());
+#endif
+        return buff;
+    }
 
+    // empty files and files that cannot be mapped are read
+    AssetFilePtr fp = OpenFile(filePath, AssetOpenMode::RK_OPEN_BINARY);
     if(fp)
     {
         size_t length = GetSize(fp);
-        Ref<uint8_t> data = Ref<uint8_t>(new uint8_t[length], [](uint8_t* v){ delete[]v; });
-        length = fread(data.get(), 1, length, static_cast<FILE*>(fp));
+        if (length > 0)
+        {
+            buff = Buffer(length, 16, ReadBufferAllocator(length));
+            length = fread(buff.GetPointer(), 1, length, static_cast<FILE*>(fp));
+            buff = buff.Slice(0, length);
+        }
 #ifdef RK_DEBUG
         RK_CORE_TRACE("Read file '{}', {} bytes", filePath, length);
 #endif
-        buff.SetData(data, length);
-
         CloseFile(fp);
     }
     else
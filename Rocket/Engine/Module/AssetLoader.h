@@ -50,6 +50,7 @@ namespace Rocket
         void Finalize() final;
 
         void Tick(Timestep ts) final;
+        void DeclareTickAccess(ModuleTickAccess& access) const final { access.Write("asset"_sid).AnyThread(); }
 
         // Support JPEG baseline & progressive (12 bpc/arithmetic not supported, same as stock IJG lib)
         // PNG 1 / 2 / 4 / 8 / 16 - bit - per - channel
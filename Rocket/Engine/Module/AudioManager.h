@@ -27,6 +27,7 @@ namespace Rocket
         void Finalize() final;
 
         void Tick(Timestep ts) final;
+        void DeclareTickAccess(ModuleTickAccess& access) const final { access.Write("audio"_sid).AnyThread(); }
         
         // TODO : use asset loader
         void LoadAudio(const String& filename);
@@ -4,10 +4,18 @@
 //#include "Module/GraphicsManager.h"
 //#include "Common/Mallocator.h"
 
-#include <GLFW/glfw3.h>
+#include "Event/GLFWEventSource.h"
+#include "Event/SyntheticEventSource.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
 
 using namespace Rocket;
 
+// any thread listener calls per worker task
+static const size_t kAnyThreadChunk = 64;
+
 EventManager* EventManager::s_Instance = nullptr;
 ElapseTimer* Rocket::g_EventTimer;
 
@@ -20,191 +28,103 @@ int EventManager::Initialize()
 
     m_ActiveEventQueue = 0;
 
-    m_WindowHandle = static_cast<GLFWwindow*>(g_WindowManager->GetNativeWindow());
-    m_Data.Title = Application::Get().GetName();
-        
-    glfwSetWindowUserPointer(m_WindowHandle, &m_Data);
+    // intern the known event types up front, in the order they are listed
+    auto& config = g_Application->GetConfig();
+    for (uint32_t i = 1; ; ++i)
+    {
+        String key = fmt::format("event_name_{:03}", i);
+        if (!config->HasConfigInfo("Event", key))
+            break;
+        InternEventType(EventHashTable::HashString(config->GetConfigInfo<String>("Event", key)));
+    }
 
-    SetupCallback();
-    SetupListener();
+    // record or replay input, replay wins when both are set
+    if (config->HasConfigInfo("Event", "replay_file"))
+    {
+        auto replay_file = config->GetConfigInfo<String>("Event", "replay_file");
+        if (!replay_file.empty())
+            StartReplay(replay_file, config->GetConfigInfo<bool>("Event", "replay_realtime"));
+    }
+    if (config->HasConfigInfo("Event", "record_file") && !m_pReplayer)
+    {
+        auto record_file = config->GetConfigInfo<String>("Event", "record_file");
+        if (!record_file.empty())
+            StartRecording(record_file);
+    }
+
+    if (config->HasConfigInfo("Event", "coalesce"))
+    {
+        auto coalesce = config->GetConfigInfo<std::map<String, String>>("Event", "coalesce");
+        for (auto& [name, policy] : coalesce)
+        {
+            if (policy == "keep_latest")
+                SetCoalesce(EventHashTable::HashString(name), EventCoalesce::KeepLatest);
+            else if (policy == "accumulate")
+                SetCoalesce(EventHashTable::HashString(name), EventCoalesce::Accumulate);
+            else if (policy != "keep_all")
+                RK_EVENT_WARN("Unknown Event Coalesce {} For {}", policy, name);
+        }
+    }
+
+    // live input from the window, a headless one has none unless made up
+    auto window = static_cast<GLFWwindow*>(g_WindowManager->GetNativeWindow());
+    if (window)
+    {
+        SetInputSource(CreateScope<GLFWEventSource>(window));
+    }
+    else if (config->HasConfigInfo("Event", "synthetic_events"))
+    {
+        auto events = config->GetConfigInfo<uint32_t>("Event", "synthetic_events");
+        auto frames = config->GetConfigInfo<uint32_t>("Event", "synthetic_frames");
+        if (events > 0)
+        {
+            SetInputSource(CreateScope<SyntheticEventSource>(
+                events, frames, g_WindowManager->GetWindowWidth(), g_WindowManager->GetWindowHeight()));
+        }
+    }
 
     m_Timer.Start();
 
     return 0;
 }
 
-void EventManager::SetupCallback()
+void EventManager::Finalize()
 {
-    // Set GLFW callbacks
-	glfwSetWindowSizeCallback(m_WindowHandle, [](GLFWwindow *window, int width, int height) {
-		RK_EVENT_TRACE("glfwSetWindowSizeCallback");
-        WindowData &data = *(WindowData *)glfwGetWindowUserPointer(window);
-	});
-
-	glfwSetWindowContentScaleCallback(m_WindowHandle, [](GLFWwindow *window, float xscale, float yscale) {
-		RK_EVENT_TRACE("glfwSetWindowContentScaleCallback");
-        WindowData &data = *(WindowData *)glfwGetWindowUserPointer(window);
-	});
-
-	glfwSetWindowRefreshCallback(m_WindowHandle, [](GLFWwindow *window) {
-		RK_EVENT_TRACE("glfwSetWindowRefreshCallback");
-        WindowData &data = *(WindowData *)glfwGetWindowUserPointer(window);
-
-        EventVarPtr ptr = Ref<Variant>(new Variant[1], [](Variant* v){ delete[]v; });
-        ptr.get()[0].type = Variant::TYPE_STRING_ID;
-        ptr.get()[0].m_asStringId = EventHashTable::HashString("window_refresh");
-        EventPtr event = CreateRef<Event>(ptr, 1);
-
-        data.EventCallback(event);
-	});
-
-	glfwSetFramebufferSizeCallback(m_WindowHandle, [](GLFWwindow *window, int width, int height) {
-        RK_EVENT_TRACE("glfwSetFramebufferSizeCallback");
-		WindowData &data = *(WindowData *)glfwGetWindowUserPointer(window);
-
-        EventVarPtr ptr = Ref<Variant>(new Variant[4], [](Variant* v){ delete[]v; });
-        ptr.get()[0].type = Variant::TYPE_STRING_ID;
-        ptr.get()[0].m_asStringId = EventHashTable::HashString("window_resize");
-        ptr.get()[1].type = Variant::TYPE_INT32;
-        ptr.get()[1].m_asInt32 = width;
-        ptr.get()[2].type = Variant::TYPE_INT32;
-        ptr.get()[2].m_asInt32 = height;
-        ptr.get()[3].type = Variant::TYPE_INT32;
-        ptr.get()[3].m_asInt32 = 0;
-        EventPtr event = CreateRef<Event>(ptr, 4);
-
-		data.EventCallback(event);
-	});
-
-	glfwSetWindowCloseCallback(m_WindowHandle, [](GLFWwindow *window) {
-        RK_EVENT_TRACE("glfwSetWindowCloseCallback");
-		WindowData &data = *(WindowData *)glfwGetWindowUserPointer(window);
-
-        EventVarPtr ptr = Ref<Variant>(new Variant[1], [](Variant* v){ delete[]v; });
-        ptr.get()[0].type = Variant::TYPE_STRING_ID;
-        ptr.get()[0].m_asStringId = EventHashTable::HashString("window_close");
-        EventPtr event = CreateRef<Event>(ptr, 1);
-
-        data.EventCallback(event);
-	});
-
-	glfwSetKeyCallback(m_WindowHandle, [](GLFWwindow *window, int key, int scancode, int action, int mods) {
-        //RK_EVENT_TRACE("glfwSetKeyCallback");
-		WindowData &data = *(WindowData *)glfwGetWindowUserPointer(window);
-
-        EventVarPtr ptr = Ref<Variant>(new Variant[3], [](Variant* v){ delete[]v; });
-        ptr.get()[0].type = Variant::TYPE_STRING_ID;
-        ptr.get()[0].m_asStringId = 0;
-        ptr.get()[1].type = Variant::TYPE_INT32;
-        ptr.get()[1].m_asInt32 = scancode;
-        ptr.get()[2].type = Variant::TYPE_INT32;
-        ptr.get()[2].m_asInt32 = 0;
-
-		switch (action)
-		{
-            case GLFW_PRESS: {
-                ptr.get()[0].m_asStringId = EventHashTable::HashString("key_press");
-                ptr.get()[2].m_asInt32 = 0;
-            } break;
-            case GLFW_RELEASE: {
-                ptr.get()[0].m_asStringId = EventHashTable::HashString("key_release");
-                ptr.get()[2].m_asInt32 = 0;
-            } break;
-            case GLFW_REPEAT: {
-                ptr.get()[0].m_asStringId = EventHashTable::HashString("key_repeat");
-                ptr.get()[2].m_asInt32 = 1;
-            } break;
-		}
-        EventPtr event = CreateRef<Event>(ptr, 3);
-        data.EventCallback(event);
-	});
-
-	glfwSetCharCallback(m_WindowHandle, [](GLFWwindow *window, uint32_t keycode) {
-        //RK_EVENT_TRACE("glfwSetCharCallback");
-		WindowData &data = *(WindowData *)glfwGetWindowUserPointer(window);
-
-        EventVarPtr ptr = Ref<Variant>(new Variant[2], [](Variant* v){ delete[]v; });
-        ptr.get()[0].type = Variant::TYPE_STRING_ID;
-        ptr.get()[0].m_asStringId = EventHashTable::HashString("key_char_code");
-        ptr.get()[1].type = Variant::TYPE_UINT32;
-        ptr.get()[1].m_asUInt32 = keycode;
-        EventPtr event = CreateRef<Event>(ptr, 2);
-
-        data.EventCallback(event);
-	});
-
-	glfwSetMouseButtonCallback(m_WindowHandle, [](GLFWwindow *window, int button, int action, int mods) {
-        //RK_EVENT_TRACE("glfwSetMouseButtonCallback");
-		WindowData &data = *(WindowData *)glfwGetWindowUserPointer(window);
-
-        EventVarPtr ptr = Ref<Variant>(new Variant[2], [](Variant* v){ delete[]v; });
-        ptr.get()[0].type = Variant::TYPE_STRING_ID;
-        ptr.get()[0].m_asStringId = 0;
-        ptr.get()[1].type = Variant::TYPE_INT32;
-        ptr.get()[1].m_asInt32 = button;
-
-		switch (action)
-		{
-            case GLFW_PRESS: {
-                ptr.get()[0].m_asStringId = EventHashTable::HashString("mouse_button_press");
-            } break;
-            case GLFW_RELEASE: {
-                ptr.get()[0].m_asStringId = EventHashTable::HashString("mouse_button_release");
-            } break;
-		}
-
-        EventPtr event = CreateRef<Event>(ptr, 2);
-        data.EventCallback(event);
-	});
-
-	glfwSetScrollCallback(m_WindowHandle, [](GLFWwindow *window, double xOffset, double yOffset) {
-        //RK_EVENT_TRACE("glfwSetScrollCallback");
-		WindowData &data = *(WindowData *)glfwGetWindowUserPointer(window);
-            
-        EventVarPtr ptr = Ref<Variant>(new Variant[3], [](Variant* v){ delete[]v; });
-        ptr.get()[0].type = Variant::TYPE_STRING_ID;
-        ptr.get()[0].m_asStringId = EventHashTable::HashString("mouse_scroll");
-        ptr.get()[1].type = Variant::TYPE_DOUBLE;
-        ptr.get()[1].m_asDouble = xOffset;
-        ptr.get()[2].type = Variant::TYPE_DOUBLE;
-        ptr.get()[2].m_asDouble = yOffset;
-        EventPtr event = CreateRef<Event>(ptr, 3);
-			
-        data.EventCallback(event);
-	});
-
-	glfwSetCursorPosCallback(m_WindowHandle, [](GLFWwindow *window, double xPos, double yPos) {
-        //RK_EVENT_TRACE("glfwSetCursorPosCallback");
-		WindowData &data = *(WindowData *)glfwGetWindowUserPointer(window);
-
-        EventVarPtr ptr = Ref<Variant>(new Variant[3], [](Variant* v){ delete[]v; });
-        ptr.get()[0].type = Variant::TYPE_STRING_ID;
-        ptr.get()[0].m_asStringId = EventHashTable::HashString("mouse_move");
-        ptr.get()[1].type = Variant::TYPE_DOUBLE;
-        ptr.get()[1].m_asDouble = xPos;
-        ptr.get()[2].type = Variant::TYPE_DOUBLE;
-        ptr.get()[2].m_asDouble = yPos;
-        EventPtr event = CreateRef<Event>(ptr, 3);
-
-		data.EventCallback(event);
-	});
+    StopRecording();
+    SetInputSource(nullptr);
+    m_pReplayer.reset();
+    WaitLanes();
+
+    delete g_EventTimer;
+    g_EventTimer = nullptr;
 }
 
-void EventManager::SetupListener()
+void EventManager::OnEvent(Event& event)
 {
-    SetEventCallback(std::bind(&EventManager::OnEvent, this, std::placeholders::_1));
+    if (m_pReplayer)
+        return;
+    HandleInput(event);
 }
 
-void EventManager::Finalize()
+void EventManager::SetInputSource(Scope<IEventSource> source)
 {
-    delete g_EventTimer;
+    if (m_pInput)
+        m_pInput->Finalize();
+    m_pInput = std::move(source);
+    if (m_pInput)
+        m_pInput->Initialize([this](Event& event) { OnEvent(event); });
 }
 
-void EventManager::OnEvent(EventPtr& event)
+void EventManager::HandleInput(Event& event)
 {
+    if (m_pRecorder)
+        m_pRecorder->Record(event, EventRecordKind::Input);
+
     bool ret = false;
-    //RK_EVENT_TRACE("Callback Event {0}", *event);
-    if(event->GetEventType() == EventHashTable::HashString("window_close"))
+    //RK_EVENT_TRACE("Callback Event {0}", event);
+    EventTypeId id = FindEventType(event.GetEventType());
+    bool coalesced = id != kInvalidEventTypeId && m_ListenerSlots[id].Coalesce != EventCoalesce::KeepAll;
+    if(coalesced || event.GetEventType() == "window_close"_sid)
         ret = QueueEvent(event);
     else
         ret = TriggerEvent(event);
@@ -217,7 +137,25 @@ void EventManager::Tick(Timestep ts)
 
     Rocket::g_EventTimer->MarkLapping();
 
-    glfwPollEvents();
+    double now = g_EventTimer->GetExactTime();
+    bool finished = false;
+    if (m_pInput && !m_pInput->Poll(now))
+    {
+        SetInputSource(nullptr);
+        finished = true;
+    }
+    if (m_pReplayer && !m_pReplayer->Poll(now))
+    {
+        RK_EVENT_INFO("Event Replay Finished After {} Frames", m_pReplayer->GetFrameCount());
+        m_pReplayer.reset();
+        finished = true;
+    }
+    // a headless run ends with its input, as if the window was closed
+    if (finished && !m_pInput && !m_pReplayer)
+    {
+        Event event("window_close"_sid);
+        QueueEvent(event);
+    }
 
     m_Timer.MarkLapping();
     bool result = Update();
@@ -226,6 +164,10 @@ void EventManager::Tick(Timestep ts)
         RK_EVENT_WARN("EventManager Process Unfinish!");
     }
 
+    // the input of this frame is in the log ahead of its mark
+    if (m_pRecorder)
+        m_pRecorder->RecordFrame(g_EventTimer->GetExactTime());
+
     PROFILE_END_CPU_SAMPLE();
 }
 
@@ -235,51 +177,53 @@ bool EventManager::Update(uint64_t maxMillis)
     double maxMs = currMs + maxMillis;
 
     // This section added to handle events from other threads.
-    EventPtr pRealtimeEvent;
-    while (m_EventThreadQueue.try_pop(pRealtimeEvent))
+    Event realtimeEvent;
+    while (m_EventThreadQueue.Pop(realtimeEvent))
     {
-        QueueEvent(pRealtimeEvent);
+        QueueEvent(realtimeEvent);
         currMs = m_Timer.GetElapsedTime();
         if (currMs >= maxMs)
         {
-            RK_EVENT_WARN("A realtime process is spamming the event manager! {}", *pRealtimeEvent);
+            // the rest waits in the ring for the next update
+            RK_EVENT_WARN("A realtime process is spamming the event manager! {}", realtimeEvent);
+            break;
         }
     }
 
+    // timed events that came due join the queue behind the ones already in it,
+    // with none scheduled the wheel only moves its clock
+    if (g_EventTimer)
+    {
+        uint64_t now = static_cast<uint64_t>(g_EventTimer->GetExactTime());
+        m_TimedEvents.Advance(now, [this](const Event& event) { QueueEvent(event); });
+    }
+
+    uint64_t dropped = m_EventThreadQueue.GetDropped();
+    if (dropped != m_nDroppedEvents)
+    {
+        RK_EVENT_WARN("Thread event queue full, {} events dropped", dropped - m_nDroppedEvents);
+        m_nDroppedEvents = dropped;
+    }
+
     // swap active queues and clear the new queue after the swap
     int queueToProcess = m_ActiveEventQueue;
     m_ActiveEventQueue = (m_ActiveEventQueue + 1) % EVENTMANAGER_NUM_QUEUES;
     m_EventQueue[m_ActiveEventQueue].clear();
+    ++m_nQueueGeneration;
 
     //RK_EVENT_INFO("Processing Event Queue {0} - {1} events to process", queueToProcess, m_EventQueue[queueToProcess].size());
 
-    // Process the queue
-    while (!m_EventQueue[queueToProcess].empty())
+    // Process the queue, listeners only queue into the active one meanwhile
+    EventQueue& queue = m_EventQueue[queueToProcess];
+    size_t next = 0;
+    while (next < queue.size())
     {
-        // pop the front of the queue
-        EventPtr pEvent = m_EventQueue[queueToProcess].front();
-        m_EventQueue[queueToProcess].pop_front();
+        EventPtr pEvent = &queue[next++];
         RK_EVENT_INFO("\tProcessing Event {0}", pEvent->GetName());
 
-        const EventType& eventType = pEvent->GetEventType();
-
-        // find all the delegate functions registered for this event
-        auto findIt = m_EventListener.find(eventType);
-        if (findIt != m_EventListener.end())
-        {
-            const EventListenerList& eventListeners = findIt->second;
-            RK_EVENT_INFO("\tFound {0} delegates", (unsigned long)eventListeners.size());
-
-            // call each listener
-            for (auto it = eventListeners.begin(); it != eventListeners.end(); ++it)
-            {
-                EventListenerDelegate listener = (*it);
-                RK_EVENT_INFO("\tSending event {0} to delegate", pEvent->GetName());
-                bool processed = listener(pEvent);
-                if (processed)
-                    break;
-            }
-        }
+        EventTypeId id = FindEventType(pEvent->GetEventType());
+        if (id != kInvalidEventTypeId)
+            DispatchEvent(pEvent, id);
 
         // check to see if time ran out
         currMs = m_Timer.GetElapsedTime();
@@ -289,131 +233,414 @@ bool EventManager::Update(uint64_t maxMillis)
             break;
         }
     }
-        
-    // If we couldn't process all of the events, push the remaining events to the new active queue.
-    // Note: To preserve sequencing, go back-to-front, inserting them at the head of the active queue
-    bool queueFlushed = (m_EventQueue[queueToProcess].empty());
+
+    // If we couldn't process all of the events, move the remaining events to the head
+    // of the new active queue, ahead of the ones queued meanwhile and in their order
+    bool queueFlushed = (next == queue.size());
     if (!queueFlushed)
     {
-        while (!m_EventQueue[queueToProcess].empty())
+        EventQueue& active = m_EventQueue[m_ActiveEventQueue];
+        active.insert(active.begin(), queue.begin() + next, queue.end());
+        ++m_nQueueGeneration;
+    }
+    // keeps its capacity, steady traffic does not allocate
+    queue.clear();
+
+    // by index, a listener may create a channel and grow the list; the new
+    // one is updated from the next frame on
+    size_t channels = m_Channels.size();
+    for (size_t i = 0; i < channels; ++i)
+    {
+        if (m_Channels[i])
+            m_Channels[i]->Update();
+    }
+
+    // hand what the off main thread listeners got this frame to the workers
+    SubmitLanes();
+
+    return queueFlushed;
+}
+
+EventTypeId EventManager::FindEventType(EventType type) const
+{
+    if (m_TypeIndex.empty())
+        return kInvalidEventTypeId;
+    size_t mask = m_TypeIndex.size() - 1;
+    for (size_t i = type & mask; ; i = (i + 1) & mask)
+    {
+        const TypeIndexEntry& entry = m_TypeIndex[i];
+        if (entry.Id == kInvalidEventTypeId || entry.Type == type)
+            return entry.Id;
+    }
+}
+
+EventTypeId EventManager::InternEventType(EventType type)
+{
+    EventTypeId id = FindEventType(type);
+    if (id != kInvalidEventTypeId)
+        return id;
+
+    id = static_cast<EventTypeId>(m_ListenerSlots.size());
+    m_ListenerSlots.emplace_back(type, &m_MemoryResource);
+
+    // keep the index at most half full, probes stay short
+    if (m_ListenerSlots.size() * 2 > m_TypeIndex.size())
+        RebuildTypeIndex(std::max<size_t>(16, m_TypeIndex.size() * 2));
+    else
+    {
+        size_t mask = m_TypeIndex.size() - 1;
+        size_t i = type & mask;
+        while (m_TypeIndex[i].Id != kInvalidEventTypeId)
+            i = (i + 1) & mask;
+        m_TypeIndex[i] = {type, id};
+    }
+    return id;
+}
+
+void EventManager::RebuildTypeIndex(size_t size)
+{
+    m_TypeIndex.assign(size, TypeIndexEntry{});
+    size_t mask = size - 1;
+    for (EventTypeId id = 0; id < m_ListenerSlots.size(); ++id)
+    {
+        EventType type = m_ListenerSlots[id].Type;
+        size_t i = type & mask;
+        while (m_TypeIndex[i].Id != kInvalidEventTypeId)
+            i = (i + 1) & mask;
+        m_TypeIndex[i] = {type, id};
+    }
+}
+
+bool EventManager::DispatchEvent(EventPtr& pEvent, EventTypeId id)
+{
+    // by index with the count taken up front: a listener may add listeners,
+    // which can move both arrays, and the ones it adds wait for the next event
+    bool processed = false;
+    ++m_nDispatchDepth;
+    auto bridge = m_ListenerSlots[id].Bridge;
+    if (bridge)
+        processed = bridge(m_ListenerSlots[id].Channel, *pEvent);
+    size_t count = processed ? 0 : m_ListenerSlots[id].Listeners.size();
+    for (size_t i = 0; i < count; ++i)
+    {
+        EventListener listener = m_ListenerSlots[id].Listeners[i];
+        // removed during dispatch
+        if (!listener.Delegate)
+            continue;
+        if (listener.Lane != kMainThreadLaneIndex)
         {
-            EventPtr pEvent = m_EventQueue[queueToProcess].back();
-            m_EventQueue[queueToProcess].pop_back();
-            m_EventQueue[m_ActiveEventQueue].push_back(pEvent);
+            m_Lanes[listener.Lane].Pending.push_back({*pEvent, listener.Delegate});
+            continue;
         }
+        processed = listener.Delegate(pEvent);
+        if (processed)
+            break;
     }
-        
-    return queueFlushed;
+    if (--m_nDispatchDepth == 0 && m_bListenersDirty)
+        CompactListeners();
+    return processed;
+}
+
+void EventManager::CompactListeners()
+{
+    for (auto& slot : m_ListenerSlots)
+    {
+        if (!slot.Dirty)
+            continue;
+        auto& listeners = slot.Listeners;
+        listeners.erase(std::remove_if(listeners.begin(), listeners.end(),
+            [](const EventListener& listener) { return !listener.Delegate; }), listeners.end());
+        slot.Dirty = false;
+    }
+    m_bListenersDirty = false;
+}
+
+void EventManager::SetCoalesce(EventType type, EventCoalesce coalesce)
+{
+    m_ListenerSlots[InternEventType(type)].Coalesce = coalesce;
+}
+
+uint32_t EventManager::InternLane(EventLane lane)
+{
+    for (uint32_t i = 0; i < m_Lanes.size(); ++i)
+    {
+        if (m_Lanes[i].Id == lane)
+            return i;
+    }
+    // workers hold on to the buffers of the running lanes
+    WaitLanes();
+    m_Lanes.emplace_back(lane, &m_MemoryResource);
+    return static_cast<uint32_t>(m_Lanes.size() - 1);
+}
+
+void EventManager::SubmitLanes()
+{
+    // the previous frame's work is done before its buffers are reused,
+    // which also keeps each lane in order across frames
+    WaitLanes();
+
+    for (auto& lane : m_Lanes)
+    {
+        std::swap(lane.Pending, lane.Running);
+        lane.Pending.clear();
+        if (lane.Running.empty())
+            continue;
+
+        // a named lane is one task, any thread work is split up
+        LaneTask* tasks = lane.Running.data();
+        size_t count = lane.Running.size();
+        size_t chunk = lane.Id == kAnyThreadLane ? kAnyThreadChunk : count;
+        for (size_t begin = 0; begin < count; begin += chunk)
+        {
+            size_t end = std::min(count, begin + chunk);
+            auto run = [tasks, begin, end]() {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    EventPtr pEvent = &tasks[i].Data;
+                    tasks[i].Delegate(pEvent);
+                }
+            };
+            if (m_pJobSystem)
+                m_pJobSystem->Run(m_LaneJobs, run);
+            else
+                run();
+        }
+        m_bLanesRunning = m_pJobSystem != nullptr;
+    }
+}
+
+void EventManager::WaitLanes()
+{
+    if (!m_bLanesRunning)
+        return;
+    // helps with the lanes meanwhile, so their listeners may run here too
+    m_pJobSystem->Wait(m_LaneJobs);
+    m_bLanesRunning = false;
 }
 
-bool EventManager::AddListener(const EventListenerDelegate& eventDelegate, const EventType& type)
+bool EventManager::AddListener(const EventListenerDelegate& eventDelegate, const EventType& type, EventLane lane)
 {
-    EventListenerList& eventListenerList = m_EventListener[type];  // this will find or create the entry
+    uint32_t laneIndex = lane == kMainThreadLane ? kMainThreadLaneIndex : InternLane(lane);
+    EventListenerList& eventListenerList = m_ListenerSlots[InternEventType(type)].Listeners;
     for (auto it = eventListenerList.begin(); it != eventListenerList.end(); ++it)
     {
         // Must use function pointer as listener
-        if (eventDelegate == (*it))
+        if (eventDelegate == it->Delegate)
         {
             RK_EVENT_WARN("Attempting to double-register a delegate");
             return false;
         }
     }
-    eventListenerList.push_back(eventDelegate);
+    eventListenerList.push_back({eventDelegate, laneIndex});
     return true;
 }
 
 bool EventManager::RemoveListener(const EventListenerDelegate& eventDelegate, const EventType& type)
 {
-    bool success = false;
-    auto findIt = m_EventListener.find(type);
-    if (findIt != m_EventListener.end())
+    EventTypeId id = FindEventType(type);
+    if (id == kInvalidEventTypeId)
+        return false;
+
+    ListenerSlot& slot = m_ListenerSlots[id];
+    auto it = std::find_if(slot.Listeners.begin(), slot.Listeners.end(),
+        [&](const EventListener& listener) { return listener.Delegate == eventDelegate; });
+    if (it == slot.Listeners.end())
+        return false;
+
+    // nothing may call it once this returns, also not with events already handed over
+    if (it->Lane != kMainThreadLaneIndex)
     {
-        EventListenerList& listeners = findIt->second;
-        for (auto it = listeners.begin(); it != listeners.end(); ++it)
-        {
-            // Must use function pointer as listener
-            if (eventDelegate == (*it))
-            {
-                listeners.erase(it);
-                RK_EVENT_INFO("Successfully removed delegate function from event type {0}", EventHashTable::GetStringFromId(type));
-                success = true;
-                break;
-            }
-        }
+        WaitLanes();
+        auto& pending = m_Lanes[it->Lane].Pending;
+        pending.erase(std::remove_if(pending.begin(), pending.end(),
+            [&](const LaneTask& task) { return task.Delegate == eventDelegate; }), pending.end());
     }
-    return success;
+
+    // while dispatching only clear the entry, indices must not move
+    if (m_nDispatchDepth > 0)
+    {
+        it->Delegate = EventListenerDelegate{};
+        slot.Dirty = true;
+        m_bListenersDirty = true;
+    }
+    else
+        slot.Listeners.erase(it);
+    RK_EVENT_INFO("Successfully removed delegate function from event type {0}", EventHashTable::GetStringFromId(type));
+    return true;
 }
 
-bool EventManager::TriggerEvent(EventPtr& event) const
+bool EventManager::TriggerEvent(Event& event)
 {
-    bool processed = false;
-    auto findIt = m_EventListener.find(event->GetEventType());
-    if (findIt != m_EventListener.end())
+    if (m_pRecorder)
+        m_pRecorder->Record(event, EventRecordKind::Triggered);
+
+    EventTypeId id = FindEventType(event.GetEventType());
+    if (id == kInvalidEventTypeId)
+        return false;
+    EventPtr pEvent = &event;
+    return DispatchEvent(pEvent, id);
+}
+
+// numeric payload adds up, anything else takes the newer value
+static void AccumulateEvent(Event& pending, const Event& event)
+{
+    if (pending.Count != event.Count)
     {
-        const EventListenerList& eventListenerList = findIt->second;
-        for (EventListenerList::const_iterator it = eventListenerList.begin(); it != eventListenerList.end(); ++it)
-        {
-            auto listener = (*it);
-            RK_EVENT_INFO("Sending Event {0} to delegate.", event->GetName());
-            processed = listener(event);  // call the delegate
-            if (processed)
-                break;
-        }
+        pending = event;
+        return;
     }
-    return processed;
+    for (uint32_t i = 1; i < event.Count; ++i)
+    {
+        Variant& var = pending.Var[i];
+        const Variant& add = event.Var[i];
+        if (var.type != add.type)
+            var = add;
+        else if (var.type == Variant::TYPE_INT32)
+            var.m_asInt32 += add.m_asInt32;
+        else if (var.type == Variant::TYPE_UINT32)
+            var.m_asUInt32 += add.m_asUInt32;
+        else if (var.type == Variant::TYPE_FLOAT)
+            var.m_asFloat += add.m_asFloat;
+        else if (var.type == Variant::TYPE_DOUBLE)
+            var.m_asDouble += add.m_asDouble;
+        else
+            var = add;
+    }
+    pending.TimeStamp = event.TimeStamp;
 }
 
-bool EventManager::QueueEvent(const EventPtr& event)
+bool EventManager::QueueEvent(const Event& event)
 {
     RK_CORE_ASSERT(m_ActiveEventQueue >= 0, "EventManager Active Queue Error");
     RK_CORE_ASSERT(m_ActiveEventQueue < EVENTMANAGER_NUM_QUEUES, "EventManager Active Queue Error");
 
-    RK_EVENT_INFO("Attempting to queue event: {0}", event->GetName());
+    RK_EVENT_INFO("Attempting to queue event: {0}", event.GetName());
+
+    if (m_pRecorder)
+        m_pRecorder->Record(event, EventRecordKind::Queued);
 
-    auto findIt = m_EventListener.find(event->GetEventType());
-    if (findIt != m_EventListener.end())
+    EventTypeId id = FindEventType(event.GetEventType());
+    if (id != kInvalidEventTypeId && (!m_ListenerSlots[id].Listeners.empty() || m_ListenerSlots[id].Bridge))
     {
-        m_EventQueue[m_ActiveEventQueue].push_back(event);
-        RK_EVENT_INFO("Successfully queued event: {0}", event->GetName());
+        ListenerSlot& slot = m_ListenerSlots[id];
+        EventQueue& queue = m_EventQueue[m_ActiveEventQueue];
+        if (slot.Coalesce != EventCoalesce::KeepAll && slot.PendingGeneration == m_nQueueGeneration)
+        {
+            // merge into the one already queued, it keeps its place in the queue
+            Event& pending = queue[slot.Pending];
+            if (slot.Coalesce == EventCoalesce::Accumulate)
+                AccumulateEvent(pending, event);
+            else
+                pending = event;
+            RK_EVENT_INFO("Coalesced event: {0}", event.GetName());
+            return true;
+        }
+        slot.Pending = static_cast<uint32_t>(queue.size());
+        slot.PendingGeneration = m_nQueueGeneration;
+        queue.push_back(event);
+        RK_EVENT_INFO("Successfully queued event: {0}", event.GetName());
         return true;
     }
     else
     {
-        RK_EVENT_INFO("Skipping event since there are no delegates registered: {0}", event->GetName());
+        RK_EVENT_INFO("Skipping event since there are no delegates registered: {0}", event.GetName());
         return false;
     }
 }
 
-bool EventManager::ThreadSafeQueueEvent(const EventPtr& event)
+bool EventManager::ThreadSafeQueueEvent(const Event& event)
 {
-    m_EventThreadQueue.push(event);
+    return m_EventThreadQueue.Push(event);
+}
+
+bool EventManager::StartRecording(const String& path)
+{
+    m_pRecorder = CreateScope<EventRecorder>();
+    if (!m_pRecorder->Start(path))
+    {
+        m_pRecorder.reset();
+        return false;
+    }
+    RK_EVENT_INFO("Recording Events To {}", path);
     return true;
 }
 
+void EventManager::StopRecording()
+{
+    if (!m_pRecorder)
+        return;
+    m_pRecorder->Stop();
+    RK_EVENT_INFO("Recorded {} Events", m_pRecorder->GetRecordCount());
+    m_pRecorder.reset();
+}
+
+bool EventManager::StartReplay(const String& path, bool realtime)
+{
+    m_pReplayer = CreateScope<EventReplayer>();
+    if (!m_pReplayer->Open(path, realtime))
+    {
+        m_pReplayer.reset();
+        return false;
+    }
+    // past OnEvent, which drops live input while replaying
+    m_pReplayer->Initialize([this](Event& event) { HandleInput(event); });
+    RK_EVENT_INFO("Replaying Events From {}", path);
+    return true;
+}
+
+TimerHandle EventManager::QueueEventAt(const Event& event, double time)
+{
+    RK_CORE_ASSERT(g_EventTimer, "EventManager Timed Event Without Event Timer");
+    // round up, never earlier than asked for
+    return m_TimedEvents.Insert(static_cast<uint64_t>(std::ceil(std::max(time, 0.0))), event);
+}
+
+TimerHandle EventManager::QueueEventAfter(const Event& event, double delay)
+{
+    RK_CORE_ASSERT(g_EventTimer, "EventManager Timed Event Without Event Timer");
+    return QueueEventAt(event, g_EventTimer->GetExactTime() + delay);
+}
+
+bool EventManager::CancelTimedEvent(TimerHandle handle)
+{
+    return m_TimedEvents.Cancel(handle);
+}
+
+void EventManager::SetThreadQueue(size_t capacity, const String& overflow)
+{
+    RingOverflow policy = RingOverflow::Spill;
+    if (overflow == "drop_oldest")
+        policy = RingOverflow::DropOldest;
+    else if (overflow == "block")
+        policy = RingOverflow::Block;
+    else if (overflow != "spill")
+        RK_EVENT_WARN("Unknown Thread Queue Overflow {}, Use spill", overflow);
+    m_EventThreadQueue.Reset(capacity, policy);
+    m_nDroppedEvents = 0;
+}
+
 bool EventManager::AbortEvent(const EventType& type, bool allOfType)
 {
     RK_CORE_ASSERT(m_ActiveEventQueue >= 0, "EventManager Active Queue Error");
     RK_CORE_ASSERT(m_ActiveEventQueue < EVENTMANAGER_NUM_QUEUES, "EventManager Active Queue Error");
 
     bool success = false;
-    EventListenerMap::iterator findIt = m_EventListener.find(type);
-
-    if (findIt != m_EventListener.end())
+    if (FindEventType(type) != kInvalidEventTypeId)
     {
         EventQueue& eventQueue = m_EventQueue[m_ActiveEventQueue];
         auto it = eventQueue.begin();
         while (it != eventQueue.end())
         {
-            auto thisIt = it;
-            ++it;
-
-            if ((*thisIt)->GetEventType() == type)
+            if (it->GetEventType() == type)
             {
-                eventQueue.erase(thisIt);
+                it = eventQueue.erase(it);
+                ++m_nQueueGeneration;
                 success = true;
                 if (!allOfType)
                     break;
             }
+            else
+                ++it;
         }
     }
 
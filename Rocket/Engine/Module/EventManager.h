@@ -1,30 +1,69 @@
 #pragma once
 #include "Interface/IRuntimeModule.h"
 #include "Interface/IEvent.h"
+#include "Interface/IEventSource.h"
 #include "Event/Event.h"
+#include "Event/EventChannel.h"
+#include "Event/EventRecorder.h"
 #include "Utils/Timer.h"
-#include "Utils/ThreadSafeQueue.h"
+#include "Utils/MPSCRingBuffer.h"
+#include "Utils/JobSystem.h"
+#include "Utils/TimerWheel.h"
+#include "Common/MemoryResource.h"
 
 #include <entt/entt.hpp>
 #include <functional>
-#include <queue>
-#include <list>
-#include <map>
+#include <type_traits>
 
-struct GLFWwindow;
 constexpr uint16_t EVENTMANAGER_NUM_QUEUES = 2;
 
 namespace Rocket
 {
-    using EventCallbackFn = std::function<void(EventPtr &)>;
     using EventListenerFnptr = bool(*)(EventPtr&);
     using EventListenerDelegate = entt::delegate<bool(EventPtr&)>;
     // std::function cannot compare, so use entt
     //using EventListenerDelegate = std::function<bool(EventPtr&)>;
-    using EventListenerList = std::list<EventListenerDelegate>;
-    using EventListenerMap = Map<EventType, EventListenerList>;
-    using EventQueue = std::list<EventPtr>;
-    using EventThreadQueue = ThreadSafeQueue<EventPtr>;
+
+    // Where a listener runs. Main thread listeners are called from Update or
+    // TriggerEvent, the others get a copy of the event in a job once the
+    // main thread pass of Update is done. A named lane runs its events in
+    // order, any thread listeners in no particular order. Off main thread
+    // listeners may only post events through ThreadSafeQueueEvent
+    using EventLane = uint64_t;
+    constexpr EventLane kMainThreadLane = 0;
+    constexpr EventLane kAnyThreadLane = 1;
+    // serial lane of a name, e.g. EventLaneFromName("audio")
+    inline EventLane EventLaneFromName(const String& name) { return EventHashTable::HashString(name); }
+
+    struct EventListener
+    {
+        EventListenerDelegate Delegate;
+        uint32_t Lane;      // index of its lane, kMainThreadLaneIndex on the main thread
+    };
+    constexpr uint32_t kMainThreadLaneIndex = ~0u;
+    // listeners of one event type, called in registration order
+    using EventListenerList = pmr::Vec<EventListener>;
+    // event types are interned to a dense index into the listener table
+    using EventTypeId = uint32_t;
+    constexpr EventTypeId kInvalidEventTypeId = ~0u;
+    // events are stored by value, queueing only copies the record
+    using EventQueue = pmr::Vec<Event>;
+    // producers on other threads push without a lock, Update drains it
+    using EventThreadQueue = MPSCRingBuffer<Event>;
+
+    // what QueueEvent does with an event whose type is already queued this frame
+    enum class EventCoalesce : uint8_t
+    {
+        KeepAll = 0,    // queue every event
+        KeepLatest,     // overwrite the queued one, e.g. cursor position
+        Accumulate,     // add the numeric payload to the queued one, e.g. scroll offsets
+    };
+
+    // a struct naming the string id event it is made from, see Event/InputEvents.h
+    template<typename T, typename = void>
+    struct IsBridgedEvent : std::false_type {};
+    template<typename T>
+    struct IsBridgedEvent<T, std::void_t<decltype(T::kType), decltype(T::FromEvent(std::declval<const Event&>()))>> : std::true_type {};
 
 #define REGISTER_DELEGATE_CLASS(f,x) EventListenerDelegate{entt::connect_arg<&f>, x}
 #define REGISTER_DELEGATE_FN(f) EventListenerDelegate{entt::connect_arg<&f>}
@@ -42,54 +81,175 @@ namespace Rocket
                 s_Instance = this;
             }
         }
-        virtual ~EventManager() = default;
+        // lanes still running read buffers owned here
+        virtual ~EventManager() { WaitLanes(); }
 
         virtual int Initialize() final;
         virtual void Finalize() final;
 
+        // no DeclareTickAccess, listeners may touch any module so it ticks alone
         virtual void Tick(Timestep ts) final;
 
-        void OnEvent(EventPtr& event);
+        // live input, ignored while a replay feeds recorded input
+        void OnEvent(Event& event);
+        // where live input comes from, the window unless it is headless.
+        // Null leaves replay as the only input
+        void SetInputSource(Scope<IEventSource> source);
 
         [[maybe_unused]] bool Update(uint64_t maxMillis = 100);
-        [[maybe_unused]] bool AddListener(const EventListenerDelegate& eventDelegate, const EventType& type);
+        [[maybe_unused]] bool AddListener(const EventListenerDelegate& eventDelegate, const EventType& type, EventLane lane = kMainThreadLane);
         [[maybe_unused]] bool RemoveListener(const EventListenerDelegate& eventDelegate, const EventType& type);
-        [[maybe_unused]] bool TriggerEvent(EventPtr& event) const;
-        [[maybe_unused]] bool QueueEvent(const EventPtr& event);
-        [[maybe_unused]] bool ThreadSafeQueueEvent(const EventPtr& event);
+        [[maybe_unused]] bool TriggerEvent(Event& event);
+        [[maybe_unused]] bool QueueEvent(const Event& event);
+        [[maybe_unused]] bool ThreadSafeQueueEvent(const Event& event);
+        // queue the event once g_EventTimer reaches time, in milliseconds
+        // like Event::TimeStamp, or after delay from now. Main thread only
+        [[maybe_unused]] TimerHandle QueueEventAt(const Event& event, double time);
+        [[maybe_unused]] TimerHandle QueueEventAfter(const Event& event, double delay);
+        [[maybe_unused]] bool CancelTimedEvent(TimerHandle handle);
         [[maybe_unused]] bool AbortEvent(const EventType& type, bool allOfType = false);
 
+        // size and overflow policy ("drop_oldest", "block" or "spill") of the
+        // queue behind ThreadSafeQueueEvent, set before producers start
+        void SetThreadQueue(size_t capacity, const String& overflow);
+
+        // dense index of an event type, assigned on first use. Types named
+        // in setting-event.yaml are interned at Initialize
+        EventTypeId InternEventType(EventType type);
+        EventTypeId FindEventType(EventType type) const;
+        // coalescing of queued events of one type; types not set keep all.
+        // Events of a coalesced type coming from the window are queued, so
+        // their listeners run once per frame instead of once per OS message
+        void SetCoalesce(EventType type, EventCoalesce coalesce);
+        // runs the listeners added off the main thread, without one they run
+        // on the main thread at the end of Update
+        void SetJobSystem(JobSystem* jobs) { WaitLanes(); m_pJobSystem = jobs; }
+
+        // stream window input, queued and triggered events and frame marks to path
+        bool StartRecording(const String& path);
+        void StopRecording();
+        // feed the window input of a recording back through the same path as
+        // live input, at the recorded pace or one recorded frame per Tick
+        bool StartReplay(const String& path, bool realtime);
+        bool IsReplaying() const { return m_pReplayer != nullptr; }
+
+        // typed events of struct T, e.g. GetChannel<WindowResize>().Connect<&Fn>().
+        // When T is made from a string id event, those events reach its
+        // listeners as T when they are dispatched, ahead of the string id
+        // listeners. Queued ones are dispatched with the string id queue
+        template<typename T>
+        EventChannel<T>& GetChannel();
+
         // Getter for the main global event manager.
         static EventManager* Get(void);
 
     private:
-        void SetupCallback();
-        void SetupListener();
-        // Window attributes
-		void SetEventCallback(const EventCallbackFn& callback) { m_Data.EventCallback = callback; }
+        void HandleInput(Event& event);
+        bool DispatchEvent(EventPtr& event, EventTypeId id);
+        void CompactListeners();
+        void RebuildTypeIndex(size_t size);
+        uint32_t InternLane(EventLane lane);
+        void SubmitLanes();
+        void WaitLanes();
 
     private:
-        struct WindowData
+        struct ListenerSlot
         {
-            std::string Title;
-            EventCallbackFn EventCallback;
+            ListenerSlot(EventType type, std::pmr::memory_resource* resource) : Type(type), Listeners(resource) {}
+
+            EventType   Type;
+            EventListenerList Listeners;
+            bool        Dirty = false;  // removed during dispatch, compacted after
+            EventCoalesce Coalesce = EventCoalesce::KeepAll;
+            uint32_t    PendingGeneration = 0;  // queue generation Pending refers to
+            uint32_t    Pending = 0;            // index of the queued event in the active queue
+            // typed channel the events are passed on to
+            EventChannelBase* Channel = nullptr;
+            bool (*Bridge)(EventChannelBase*, const Event&) = nullptr;
+        };
+
+        struct LaneTask
+        {
+            Event Data;
+            EventListenerDelegate Delegate;
+        };
+
+        struct Lane
+        {
+            Lane(EventLane id, std::pmr::memory_resource* resource) : Id(id), Pending(resource), Running(resource) {}
+
+            EventLane   Id;
+            pmr::Vec<LaneTask> Pending; // filled by dispatch on the main thread
+            pmr::Vec<LaneTask> Running; // read by the workers until WaitLanes
+        };
+
+        // open addressing on the string id, which already is a hash
+        struct TypeIndexEntry
+        {
+            EventType   Type = 0;
+            EventTypeId Id = kInvalidEventTypeId;
         };
 
         bool        m_Global;
-        GLFWwindow* m_WindowHandle = nullptr;
-        WindowData  m_Data;
+        Scope<IEventSource> m_pInput;
+
+        // queues and listener lists, measured on their own
+        PoolMemoryResource m_MemoryResource{"Event"};
 
-        int32_t     m_ActiveEventQueue;
-        EventQueue  m_EventQueue[2];
+        int32_t     m_ActiveEventQueue = 0;
+        EventQueue  m_EventQueue[2] = {EventQueue(&m_MemoryResource), EventQueue(&m_MemoryResource)};
+        // bumped whenever queued events move, pending indices of older ones are stale
+        uint32_t    m_nQueueGeneration = 1;
         EventThreadQueue m_EventThreadQueue;
-        EventListenerMap m_EventListener;
+        // timed events in millisecond ticks of g_EventTimer
+        TimerWheel<Event> m_TimedEvents;
+        uint64_t    m_nDroppedEvents = 0;
+        pmr::Vec<ListenerSlot> m_ListenerSlots{&m_MemoryResource};
+        pmr::Vec<TypeIndexEntry> m_TypeIndex{&m_MemoryResource};
+        // listeners may add or remove listeners while being called
+        uint32_t    m_nDispatchDepth = 0;
+        bool        m_bListenersDirty = false;
+
+        pmr::Vec<Lane> m_Lanes{&m_MemoryResource};
+        // a job per lane, the any thread lane split in chunks
+        JobSystem*  m_pJobSystem = nullptr;
+        JobCounter  m_LaneJobs;
+        bool        m_bLanesRunning = false;
+
+        // typed channels by EventChannelBase::TypeIndex
+        Vec<Scope<EventChannelBase>> m_Channels;
         
+        Scope<EventRecorder> m_pRecorder;
+        Scope<EventReplayer> m_pReplayer;
+
         ElapseTimer    m_Timer;
         
     private:
         static EventManager* s_Instance;
     };
 
+    template<typename T>
+    EventChannel<T>& EventManager::GetChannel()
+    {
+        uint32_t index = EventChannelBase::TypeIndex<T>();
+        if (index >= m_Channels.size())
+            m_Channels.resize(index + 1);
+        if (!m_Channels[index])
+        {
+            auto channel = CreateScope<EventChannel<T>>(&m_MemoryResource);
+            if constexpr (IsBridgedEvent<T>::value)
+            {
+                ListenerSlot& slot = m_ListenerSlots[InternEventType(T::kType)];
+                slot.Channel = channel.get();
+                slot.Bridge = [](EventChannelBase* base, const Event& event) {
+                    return static_cast<EventChannel<T>*>(base)->Publish(T::FromEvent(event));
+                };
+            }
+            m_Channels[index] = std::move(channel);
+        }
+        return static_cast<EventChannel<T>&>(*m_Channels[index]);
+    }
+
     EventManager* GetEventManager();
     extern EventManager* g_EventManager;
 }
\ No newline at end of file
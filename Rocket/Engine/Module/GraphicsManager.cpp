@@ -27,6 +27,16 @@ int GraphicsManager::Initialize()
         m_Frames[i] = {};
     }
 
+    // Init Frame Arenas
+    auto frame_arena_size = config->GetConfigInfo<uint32_t>("Graphics", "frame_arena_size");
+    m_FrameArenas.resize(m_MaxFrameInFlight);
+    for(size_t i = 0; i < m_MaxFrameInFlight; ++i)
+    {
+        m_FrameArenas[i] = CreateScope<FrameArena>(frame_arena_size);
+    }
+    m_FrameArenaIndex = 0;
+    g_FrameArena = m_FrameArenas[m_FrameArenaIndex].get();
+
     // Init UBOs
     m_uboDrawFrameConstant.resize(m_MaxFrameInFlight);
     m_uboLightInfo.resize(m_MaxFrameInFlight);
@@ -47,6 +57,9 @@ int GraphicsManager::Initialize()
 void GraphicsManager::Finalize()
 {
     EndScene();
+
+    g_FrameArena = nullptr;
+    m_FrameArenas.clear();
 }
 
 void GraphicsManager::Tick(Timestep ts)
@@ -69,10 +82,30 @@ void GraphicsManager::Tick(Timestep ts)
     BeginFrame(m_Frames[m_CurrentFrameIndex]);
     Draw();
     EndFrame(m_Frames[m_CurrentFrameIndex]);
+    // backends override EndFrame, so the arena is cycled here
+    AdvanceFrameArena();
 
     Present();
 }
 
+void GraphicsManager::AdvanceFrameArena()
+{
+    // the arena we move to was last used m_MaxFrameInFlight frames ago
+    m_FrameArenaIndex = (m_FrameArenaIndex + 1) % m_MaxFrameInFlight;
+    auto& arena = m_FrameArenas[m_FrameArenaIndex];
+    arena->Reset();
+    g_FrameArena = arena.get();
+
+#if defined(RK_DEBUG)
+    const auto& stats = arena->GetLastFrameStats();
+    if (stats.OverflowAllocations > 0)
+    {
+        RK_GRAPHICS_TRACE("Frame Arena {} Overflow {} of {} Allocations, Grow to {} Bytes", 
+            m_FrameArenaIndex, stats.OverflowAllocations, stats.Allocations, arena->GetStats().Capacity);
+    }
+#endif
+}
+
 void GraphicsManager::UpdateConstants()
 {
     auto& frame = m_Frames[m_CurrentFrameIndex];
@@ -193,7 +226,8 @@ Ref<FrameBuffer> GraphicsManager::GetFrameBuffer(const String& name)
 
 void GraphicsManager::DrawEdgeList(const EdgeList& edges, const Vector3f& color)
 {
-    Point3DList point_list;
+    Point3DList point_list(FrameAllocator<Point3DPtr>::Current());
+    point_list.reserve(edges.size() * 2);
     for (const auto& edge : edges)
     {
         point_list.push_back(edge->first);
@@ -204,7 +238,8 @@ void GraphicsManager::DrawEdgeList(const EdgeList& edges, const Vector3f& color)
 
 void GraphicsManager::DrawEdgeList(const EdgeList& edges, const Matrix4f& trans, const Vector3f& color)
 {
-    Point3DList point_list;
+    Point3DList point_list(FrameAllocator<Point3DPtr>::Current());
+    point_list.reserve(edges.size() * 2);
     for (const auto& edge : edges)
     {
         point_list.push_back(edge->first);
@@ -216,7 +251,8 @@ void GraphicsManager::DrawEdgeList(const EdgeList& edges, const Matrix4f& trans,
 void GraphicsManager::DrawPolygon(const Face& polygon, const Vector3f& color)
 {
     Point3DSet vertices;
-    Point3DList edges;
+    Point3DList edges(FrameAllocator<Point3DPtr>::Current());
+    edges.reserve(polygon.Edges.size() * 2);
     for (const auto& pEdge : polygon.Edges)
     {
         vertices.insert({pEdge->first, pEdge->second});
@@ -231,7 +267,8 @@ void GraphicsManager::DrawPolygon(const Face& polygon, const Vector3f& color)
 void GraphicsManager::DrawPolygon(const Face& polygon, const Matrix4f& trans, const Vector3f& color)
 {
     Point3DSet vertices;
-    Point3DList edges;
+    Point3DList edges(FrameAllocator<Point3DPtr>::Current());
+    edges.reserve(polygon.Edges.size() * 2);
     for (const auto& pEdge : polygon.Edges)
     {
         vertices.insert({pEdge->first, pEdge->second});
@@ -255,7 +292,7 @@ void GraphicsManager::DrawBox(const Vector3f& bbMin, const Vector3f& bbMax, cons
 
     // vertices
     Point3DPtr points[8];
-    for (auto& point : points) point = CreateRef<Point3D>(bbMin);
+    for (auto& point : points) point = CreateFrameRef<Point3D>(bbMin);
     *points[0] = *points[2] = *points[3] = *points[7] = bbMax;
     (*points[0].get())[0] = bbMin[0];
     (*points[2].get())[1] = bbMin[1];
@@ -265,25 +302,26 @@ void GraphicsManager::DrawBox(const Vector3f& bbMin, const Vector3f& bbMax, cons
     (*points[6].get())[0] = bbMax[0];
 
     // edges
-    EdgeList edges;
+    EdgeList edges(FrameAllocator<EdgePtr>::Current());
+    edges.reserve(12);
 
     // top
-    edges.push_back(CreateRef<Edge>(make_pair(points[0], points[3])));
-    edges.push_back(CreateRef<Edge>(make_pair(points[3], points[2])));
-    edges.push_back(CreateRef<Edge>(make_pair(points[2], points[1])));
-    edges.push_back(CreateRef<Edge>(make_pair(points[1], points[0])));
+    edges.push_back(CreateFrameRef<Edge>(make_pair(points[0], points[3])));
+    edges.push_back(CreateFrameRef<Edge>(make_pair(points[3], points[2])));
+    edges.push_back(CreateFrameRef<Edge>(make_pair(points[2], points[1])));
+    edges.push_back(CreateFrameRef<Edge>(make_pair(points[1], points[0])));
 
     // bottom
-    edges.push_back(CreateRef<Edge>(make_pair(points[4], points[7])));
-    edges.push_back(CreateRef<Edge>(make_pair(points[7], points[6])));
-    edges.push_back(CreateRef<Edge>(make_pair(points[6], points[5])));
-    edges.push_back(CreateRef<Edge>(make_pair(points[5], points[4])));
+    edges.push_back(CreateFrameRef<Edge>(make_pair(points[4], points[7])));
+    edges.push_back(CreateFrameRef<Edge>(make_pair(points[7], points[6])));
+    edges.push_back(CreateFrameRef<Edge>(make_pair(points[6], points[5])));
+    edges.push_back(CreateFrameRef<Edge>(make_pair(points[5], points[4])));
 
     // side
-    edges.push_back(CreateRef<Edge>(make_pair(points[0], points[4])));
-    edges.push_back(CreateRef<Edge>(make_pair(points[1], points[5])));
-    edges.push_back(CreateRef<Edge>(make_pair(points[2], points[6])));
-    edges.push_back(CreateRef<Edge>(make_pair(points[3], points[7])));
+    edges.push_back(CreateFrameRef<Edge>(make_pair(points[0], points[4])));
+    edges.push_back(CreateFrameRef<Edge>(make_pair(points[1], points[5])));
+    edges.push_back(CreateFrameRef<Edge>(make_pair(points[2], points[6])));
+    edges.push_back(CreateFrameRef<Edge>(make_pair(points[3], points[7])));
 
     DrawEdgeList(edges, color);
 }
@@ -300,7 +338,7 @@ void GraphicsManager::DrawBox(const Vector3f& bbMin, const Vector3f& bbMax, cons
 
     // vertices
     Point3DPtr points[8];
-    for (auto& point : points) point = CreateRef<Point3D>(bbMin);
+    for (auto& point : points) point = CreateFrameRef<Point3D>(bbMin);
     *points[0] = *points[2] = *points[3] = *points[7] = bbMax;
     (*points[0].get())[0] = bbMin[0];
     (*points[2].get())[1] = bbMin[1];
@@ -310,25 +348,26 @@ void GraphicsManager::DrawBox(const Vector3f& bbMin, const Vector3f& bbMax, cons
     (*points[6].get())[0] = bbMax[0];
 
     // edges
-    EdgeList edges;
+    EdgeList edges(FrameAllocator<EdgePtr>::Current());
+    edges.reserve(12);
 
     // top
-    edges.push_back(CreateRef<Edge>(make_pair(points[0], points[3])));
-    edges.push_back(CreateRef<Edge>(make_pair(points[3], points[2])));
-    edges.push_back(CreateRef<Edge>(make_pair(points[2], points[1])));
-    edges.push_back(CreateRef<Edge>(make_pair(points[1], points[0])));
+    edges.push_back(CreateFrameRef<Edge>(make_pair(points[0], points[3])));
+    edges.push_back(CreateFrameRef<Edge>(make_pair(points[3], points[2])));
+    edges.push_back(CreateFrameRef<Edge>(make_pair(points[2], points[1])));
+    edges.push_back(CreateFrameRef<Edge>(make_pair(points[1], points[0])));
 
     // bottom
-    edges.push_back(CreateRef<Edge>(make_pair(points[4], points[7])));
-    edges.push_back(CreateRef<Edge>(make_pair(points[7], points[6])));
-    edges.push_back(CreateRef<Edge>(make_pair(points[6], points[5])));
-    edges.push_back(CreateRef<Edge>(make_pair(points[5], points[4])));
+    edges.push_back(CreateFrameRef<Edge>(make_pair(points[4], points[7])));
+    edges.push_back(CreateFrameRef<Edge>(make_pair(points[7], points[6])));
+    edges.push_back(CreateFrameRef<Edge>(make_pair(points[6], points[5])));
+    edges.push_back(CreateFrameRef<Edge>(make_pair(points[5], points[4])));
 
     // side
-    edges.push_back(CreateRef<Edge>(make_pair(points[0], points[4])));
-    edges.push_back(CreateRef<Edge>(make_pair(points[1], points[5])));
-    edges.push_back(CreateRef<Edge>(make_pair(points[2], points[6])));
-    edges.push_back(CreateRef<Edge>(make_pair(points[3], points[7])));
+    edges.push_back(CreateFrameRef<Edge>(make_pair(points[0], points[4])));
+    edges.push_back(CreateFrameRef<Edge>(make_pair(points[1], points[5])));
+    edges.push_back(CreateFrameRef<Edge>(make_pair(points[2], points[6])));
+    edges.push_back(CreateFrameRef<Edge>(make_pair(points[3], points[7])));
 
     DrawEdgeList(edges, trans, color);
 }
@@ -3,6 +3,8 @@
 #include "Interface/IDrawPass.h"
 #include "Interface/IDispatchPass.h"
 #include "Common/GeomMath.h"
+#include "Common/FrameArena.h"
+#include "Common/MemoryResource.h"
 #include "Module/PipelineStateManager.h"
 #include "Render/FrameStructure.h"
 #include "Render/DrawBasic/Shader.h"
@@ -25,6 +27,8 @@ namespace Rocket
         virtual void Finalize() override;
 
         virtual void Tick(Timestep ts) override;
+        // renders the scene, on the thread owning the graphics context
+        virtual void DeclareTickAccess(ModuleTickAccess& access) const override { access.Read("scene"_sid).Write("graphics"_sid); }
 
         virtual void SetPipelineState(const Ref<PipelineState>& pipelineState, const Frame& frame) = 0;
 
@@ -84,12 +88,15 @@ namespace Rocket
 
         Ref<FrameBuffer> GetFrameBuffer(const String& name);
 
+        const FrameArena& GetFrameArena(uint32_t index) const { return *m_FrameArenas[index]; }
+
     protected:
 
         void InitConstants() {}
         void UpdateConstants();
         void CalculateCameraMatrix();
         void CalculateLights();
+        void AdvanceFrameArena();
 
     protected:
         uint32_t m_FrameIndex;
@@ -97,16 +104,21 @@ namespace Rocket
         uint32_t m_MaxFrameInFlight;
 
         Vec<Frame> m_Frames;
+        // one linear arena per frame in flight for transient frame data
+        Vec<Scope<FrameArena>> m_FrameArenas;
+        uint32_t m_FrameArenaIndex = 0;
         Vec<Ref<UniformBuffer>> m_uboDrawFrameConstant;
         Vec<Ref<UniformBuffer>> m_uboLightInfo;
         Vec<Ref<UniformBuffer>> m_uboDrawBatchConstant;
         Vec<Ref<UniformBuffer>> m_uboShadowMatricesConstant;
 
-        Vec<Ref<IDispatchPass>> m_InitPasses;
-        Vec<Ref<IDispatchPass>> m_DispatchPasses;
-        Vec<Ref<IDrawPass>> m_DrawPasses;
+        // passes and render targets, measured on their own
+        PoolMemoryResource m_MemoryResource{"Graphics"};
+        pmr::Vec<Ref<IDispatchPass>> m_InitPasses{&m_MemoryResource};
+        pmr::Vec<Ref<IDispatchPass>> m_DispatchPasses{&m_MemoryResource};
+        pmr::Vec<Ref<IDrawPass>> m_DrawPasses{&m_MemoryResource};
 
-        UMap<String, Ref<FrameBuffer>> m_FrameBuffers;
+        pmr::UMap<String, Ref<FrameBuffer>> m_FrameBuffers{&m_MemoryResource};
 
         Ref<PipelineState> m_CurrentPipelineState = nullptr;
         Ref<Scene> m_CurrentScene = nullptr;
@@ -0,0 +1,24 @@
+#include "Module/JobManager.h"
+#include "Module/Application.h"
+
+using namespace Rocket;
+
+JobManager* Rocket::GetJobManager() { return new JobManager(); }
+
+int JobManager::Initialize()
+{
+    // zero lets the job system size itself to the hardware
+    uint32_t worker_count = 0;
+    auto& config = g_Application->GetConfig();
+    if (config->HasConfigInfo("Job", "worker_count"))
+        worker_count = config->GetConfigInfo<uint32_t>("Job", "worker_count");
+
+    m_pJobSystem = CreateScope<JobSystem>(worker_count);
+    RK_CORE_INFO("Job System With {} Threads", m_pJobSystem->GetThreadCount());
+    return 0;
+}
+
+void JobManager::Finalize()
+{
+    m_pJobSystem.reset();
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include "Interface/IRuntimeModule.h"
+#include "Utils/JobSystem.h"
+
+namespace Rocket
+{
+    // Owns the engine job system. Initialize on the main thread, which
+    // becomes worker 0 and helps with jobs whenever it waits on them
+    class JobManager : implements IRuntimeModule
+    {
+    public:
+        RUNTIME_MODULE_TYPE(JobManager);
+        JobManager() = default;
+        virtual ~JobManager() = default;
+
+        virtual int Initialize() final;
+        virtual void Finalize() final;
+
+        virtual void Tick(Timestep ts) final {}
+        virtual void DeclareTickAccess(ModuleTickAccess& access) const final { access.Independent().AnyThread(); }
+
+        JobSystem& GetJobSystem() { return *m_pJobSystem; }
+
+    private:
+        Scope<JobSystem> m_pJobSystem;
+    };
+
+    JobManager* GetJobManager();
+    extern JobManager* g_JobManager;
+}
@@ -1,4 +1,12 @@
 #include "Module/MemoryManager.h"
+#include "Common/MemoryResource.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <sstream>
 
 using namespace Rocket;
 
@@ -6,6 +14,7 @@ MemoryManager* Rocket::GetMemoryManager() { return new MemoryManager(); }
 
 size_t* MemoryManager::m_pBlockSizeLookup = nullptr;
 BlockAllocator* MemoryManager::m_pAllocators = nullptr;
+std::mutex* MemoryManager::m_pAllocatorMutex = nullptr;
 
 std::ostream& Rocket::operator<<(std::ostream& out, MemoryType type)
 {
@@ -34,36 +43,385 @@ static const uint32_t kBlockSizes[] = {
     704, 768, 832, 896, 960, 1024
 };
 
-static const uint32_t kPageSize  = 8192;
-static const uint32_t kAlignment = 4;
-// number of elements in the block size array
-static const uint32_t kNumBlockSizes = sizeof(kBlockSizes) / sizeof(kBlockSizes[0]);
-// largest valid block size
-static const uint32_t kMaxBlockSize = kBlockSizes[kNumBlockSizes - 1];
+// 16 byte aligned, for Vector4f, Matrix4f, Quaternionf and SSE data
+static const uint32_t kBlockSizes16[] = {
+    // 16-increments
+    16, 32, 48, 64, 80, 96, 112, 128, 
+    144, 160, 176, 192, 208, 224, 240, 256,
+
+    // 64-increments
+    320, 384, 448, 512, 576, 640, 704, 768, 832, 896, 960, 1024
+};
+
+// 32 byte aligned, for AVX data
+static const uint32_t kBlockSizes32[] = {
+    // 32-increments
+    32, 64, 96, 128, 160, 192, 224, 256,
+
+    // 64-increments
+    320, 384, 448, 512, 576, 640, 704, 768, 832, 896, 960, 1024
+};
+
+// 64 byte aligned, cache line / AVX-512 data
+static const uint32_t kBlockSizes64[] = {
+    // 64-increments
+    64, 128, 192, 256, 320, 384, 448, 512, 
+    576, 640, 704, 768, 832, 896, 960, 1024
+};
+
+struct SizeClassTable
+{
+    const uint32_t* BlockSizes;
+    uint32_t NumBlockSizes;
+    uint32_t Alignment;
+};
+
+// built-in layout, used unless a generated table is loaded
+#define SIZE_CLASS_TABLE(table, alignment) { table, sizeof(table) / sizeof(table[0]), alignment }
+static const SizeClassTable kDefaultSizeClassTables[] = {
+    SIZE_CLASS_TABLE(kBlockSizes, MemoryManager::kDefaultAlignment),
+    SIZE_CLASS_TABLE(kBlockSizes16, 16),
+    SIZE_CLASS_TABLE(kBlockSizes32, 32),
+    SIZE_CLASS_TABLE(kBlockSizes64, 64),
+};
+#undef SIZE_CLASS_TABLE
+
+static const uint32_t kDefaultPageSize = 8192;
+// address space reserved for pages, only touched pages use memory
+static const size_t kPageHeapReserve = sizeof(void*) >= 8 ? (size_t(4) << 30) : (size_t(256) << 20);
+// seconds between giving free pages back to the OS
+static const float kPageReleaseInterval = 1.0f;
+// time spent per tick returning empty pages of the size classes
+static const float kTrimBudget = 0.1f;
+// empty pages each size class keeps for the next spike
+static const size_t kRetainedEmptyPages = 1;
+// pages released between two looks at the clock
+static const size_t kTrimBatch = 4;
+// number of size class tables, one per supported alignment
+static const uint32_t kNumTables = sizeof(kDefaultSizeClassTables) / sizeof(kDefaultSizeClassTables[0]);
+// upper bound of size classes over all tables, a loaded table may not exceed it
+static const uint32_t kMaxSizeClasses = 128;
+// largest valid block size, every table ends with it
+static const uint32_t kMaxBlockSize = 1024;
+
+// active layout, picked in Initialize from the built-in or a generated table
+static Vec<uint32_t> s_BlockSizes[kNumTables];
+static uint32_t s_PageSize = kDefaultPageSize;
+static uint32_t s_NumBlockSizes = 0;
+
+// requested size histogram of the recording mode, one row per table
+static std::atomic<uint32_t> s_SizeHistogram[kNumTables][kMaxBlockSize + 1];
+static bool s_bRecording = false;
+
+// blocks cached per thread and per size class
+static const uint32_t kMagazineSize = 64;
+// blocks moved between a magazine and its depot at once
+static const uint32_t kMagazineBatch = kMagazineSize / 2;
+
+// bumped on every Initialize/Finalize so caches of an old depot get dropped
+static std::atomic<uint32_t> s_Generation{0};
+
+namespace Rocket
+{
+    // Per-thread front cache, each size class owns a small stack of free blocks
+    // that is refilled from / flushed to the shared depot in batches. The
+    // magazines are allocated on first use, threads that never allocate only
+    // pay for the pointer
+    struct ThreadCache
+    {
+        struct Magazine
+        {
+            void* Blocks[kMagazineSize];
+            uint32_t Count = 0;
+            // stats not yet handed to the depot, synced whenever its lock is taken
+            ptrdiff_t LiveBlocks = 0;
+            ptrdiff_t RequestedBytes = 0;
+        };
+
+        // one per size class of the generation they were made in
+        Magazine* Magazines = nullptr;
+        uint32_t Generation = 0;
+
+        ~ThreadCache()
+        {
+            FlushAll();
+            free(Magazines);
+        }
+
+        Magazine& GetMagazine(size_t size_class)
+        {
+            uint32_t generation = s_Generation.load(std::memory_order_acquire);
+            if (Generation != generation)
+            {
+                // blocks belong to pages that no longer exist, and a loaded
+                // table may have another number of size classes
+                free(Magazines);
+                Magazines = nullptr;
+                Generation = generation;
+            }
+            if (Magazines == nullptr)
+            {
+                // zeroed is empty, no magazine memory comes from the depot
+                Magazines = static_cast<Magazine*>(calloc(s_NumBlockSizes, sizeof(Magazine)));
+                if (Magazines == nullptr)
+                    throw std::bad_alloc();
+            }
+            return Magazines[size_class];
+        }
+
+        void* Allocate(size_t size_class, size_t size)
+        {
+            Magazine& magazine = GetMagazine(size_class);
+            if (magazine.Count == 0)
+            {
+                std::lock_guard<std::mutex> lock(MemoryManager::m_pAllocatorMutex[size_class]);
+                BlockAllocator& depot = MemoryManager::m_pAllocators[size_class];
+                while (magazine.Count < kMagazineBatch)
+                    magazine.Blocks[magazine.Count++] = depot.Allocate();
+                Sync(magazine, depot);
+            }
+            // counted once handed out, a refill that throws leaves no trace
+            ++magazine.LiveBlocks;
+            magazine.RequestedBytes += size;
+            return magazine.Blocks[--magazine.Count];
+        }
+
+        void Free(void* p, size_t size_class, size_t size)
+        {
+            Magazine& magazine = GetMagazine(size_class);
+            --magazine.LiveBlocks;
+            magazine.RequestedBytes -= size;
+            if (magazine.Count == kMagazineSize)
+                Flush(size_class, kMagazineBatch);
+            magazine.Blocks[magazine.Count++] = p;
+        }
+
+        void Flush(size_t size_class, uint32_t count)
+        {
+            Magazine& magazine = Magazines[size_class];
+            std::lock_guard<std::mutex> lock(MemoryManager::m_pAllocatorMutex[size_class]);
+            BlockAllocator& depot = MemoryManager::m_pAllocators[size_class];
+            for (uint32_t i = 0; i < count && magazine.Count > 0; ++i)
+                depot.Free(magazine.Blocks[--magazine.Count]);
+            Sync(magazine, depot);
+        }
+
+        void FlushAll()
+        {
+            if (Magazines == nullptr || MemoryManager::m_pAllocators == nullptr ||
+                Generation != s_Generation.load(std::memory_order_acquire))
+                return;
+            for (size_t i = 0; i < s_NumBlockSizes; ++i)
+            {
+                if (Magazines[i].Count > 0 || Magazines[i].LiveBlocks != 0 || Magazines[i].RequestedBytes != 0)
+                    Flush(i, Magazines[i].Count);
+            }
+        }
+
+        // hand pending stats to the depot without moving blocks
+        void SyncAll()
+        {
+            if (Magazines == nullptr || MemoryManager::m_pAllocators == nullptr ||
+                Generation != s_Generation.load(std::memory_order_acquire))
+                return;
+            for (size_t i = 0; i < s_NumBlockSizes; ++i)
+            {
+                if (Magazines[i].LiveBlocks != 0 || Magazines[i].RequestedBytes != 0)
+                {
+                    std::lock_guard<std::mutex> lock(MemoryManager::m_pAllocatorMutex[i]);
+                    Sync(Magazines[i], MemoryManager::m_pAllocators[i]);
+                }
+            }
+        }
+
+        static void Sync(Magazine& magazine, BlockAllocator& depot)
+        {
+            depot.Account(magazine.LiveBlocks, magazine.RequestedBytes);
+            magazine.LiveBlocks = 0;
+            magazine.RequestedBytes = 0;
+        }
+    };
+}
+
+static thread_local ThreadCache t_ThreadCache;
+
+// allocations served by malloc, outside of any size class
+static std::atomic<size_t> s_LargeAllocations{0};
+static std::atomic<size_t> s_LargeBytes{0};
+
+static size_t LookUpTable(size_t alignment)
+{
+    for (size_t i = 0; i < kNumTables; ++i)
+    {
+        if (alignment <= kDefaultSizeClassTables[i].Alignment)
+            return i;
+    }
+    return kNumTables;
+}
+
+static void* AlignedMalloc(size_t size, size_t alignment)
+{
+    // malloc already satisfies fundamental alignment
+    if (alignment <= alignof(std::max_align_t))
+        return malloc(size);
+#if defined(PLATFORM_WINDOWS)
+    return _aligned_malloc(size, alignment);
+#else
+    void* p = nullptr;
+    if (posix_memalign(&p, alignment, size) != 0)
+        return nullptr;
+    return p;
+#endif
+}
+
+static void AlignedFree(void* p, size_t alignment)
+{
+    if (alignment <= alignof(std::max_align_t))
+        return free(p);
+#if defined(PLATFORM_WINDOWS)
+    _aligned_free(p);
+#else
+    free(p);
+#endif
+}
+
+static void UseDefaultSizeClassTable()
+{
+    s_PageSize = kDefaultPageSize;
+    s_NumBlockSizes = 0;
+    for (size_t t = 0; t < kNumTables; ++t)
+    {
+        const auto& table = kDefaultSizeClassTables[t];
+        s_BlockSizes[t].assign(table.BlockSizes, table.BlockSizes + table.NumBlockSizes);
+        s_NumBlockSizes += table.NumBlockSizes;
+    }
+}
+
+// reads a table written by size_class_tool:
+//   page_size <bytes>
+//   table <alignment> <block size> ... 1024
+// tables that are not listed keep their built-in layout
+static bool LoadSizeClassTable(const String& path)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        RK_CORE_WARN("Memory Manager cannot open size class table {}", path);
+        return false;
+    }
+
+    UseDefaultSizeClassTable();
+    Vec<uint32_t> block_sizes[kNumTables];
+    for (size_t t = 0; t < kNumTables; ++t)
+        block_sizes[t] = s_BlockSizes[t];
+    uint32_t page_size = kDefaultPageSize;
+
+    String line;
+    while (std::getline(file, line))
+    {
+        std::istringstream words(line);
+        String key;
+        if (!(words >> key) || key[0] == '#')
+            continue;
+
+        if (key == "page_size")
+        {
+            words >> page_size;
+        }
+        else if (key == "table")
+        {
+            uint32_t alignment = 0;
+            words >> alignment;
+            size_t t = LookUpTable(alignment);
+            if (t == kNumTables || kDefaultSizeClassTables[t].Alignment != alignment)
+            {
+                RK_CORE_WARN("Memory Manager size class table {}: unknown alignment {}", path, alignment);
+                return false;
+            }
+            block_sizes[t].clear();
+            uint32_t block_size;
+            while (words >> block_size)
+                block_sizes[t].push_back(block_size);
+        }
+    }
+
+    // a page has to hold the header and at least two of the largest blocks
+    bool valid = (page_size & (page_size - 1)) == 0 && page_size >= 2 * kMaxBlockSize + MemoryManager::kMaxAlignment;
+    uint32_t num_block_sizes = 0;
+    for (size_t t = 0; t < kNumTables && valid; ++t)
+    {
+        uint32_t alignment = kDefaultSizeClassTables[t].Alignment;
+        const auto& sizes = block_sizes[t];
+        valid = !sizes.empty() && sizes.back() == kMaxBlockSize;
+        for (size_t i = 0; i < sizes.size() && valid; ++i)
+            valid = sizes[i] % alignment == 0 && (i == 0 || sizes[i] > sizes[i - 1]);
+        num_block_sizes += static_cast<uint32_t>(sizes.size());
+    }
+    if (!valid || num_block_sizes > kMaxSizeClasses)
+    {
+        RK_CORE_WARN("Memory Manager size class table {} is invalid, using the built-in one", path);
+        return false;
+    }
+
+    for (size_t t = 0; t < kNumTables; ++t)
+        s_BlockSizes[t] = std::move(block_sizes[t]);
+    s_NumBlockSizes = num_block_sizes;
+    s_PageSize = page_size;
+    RK_CORE_INFO("Memory Manager loaded {} size classes, page size {} from {}", s_NumBlockSizes, s_PageSize, path);
+    return true;
+}
 
 int MemoryManager::Initialize() 
 {
     // one-time initialization
-    static bool s_bInitialized = false;
-    if (!s_bInitialized)
+    if (m_pAllocators == nullptr)
     {
-        // initialize block size lookup table
-        m_pBlockSizeLookup = new size_t[kMaxBlockSize + 1];
-        size_t j = 0;
-        for (size_t i = 0; i <= kMaxBlockSize; i++)
+        if (m_SizeClassFile.empty() || !LoadSizeClassTable(m_SizeClassFile))
+            UseDefaultSizeClassTable();
+
+        // the page heap has to exist before any allocator asks for a page
+        if (!m_PageHeap.Initialize(kPageHeapReserve, s_PageSize))
+            RK_CORE_WARN("Memory Manager failed to reserve {} bytes, pages fall back to heap", kPageHeapReserve);
+
+        m_pAllocators = new BlockAllocator[s_NumBlockSizes];
+        m_pAllocatorMutex = new std::mutex[s_NumBlockSizes];
+        m_pBlockSizeLookup = new size_t[kNumTables * (kMaxBlockSize + 1)];
+        m_nTrimCursor = 0;
+
+        size_t base = 0;
+        for (size_t t = 0; t < kNumTables; ++t)
         {
-            if (i > kBlockSizes[j]) ++j;
-            m_pBlockSizeLookup[i] = j;
+            const auto& block_sizes = s_BlockSizes[t];
+            uint32_t alignment = kDefaultSizeClassTables[t].Alignment;
+
+            // initialize block size lookup table, one row per alignment
+            size_t* lookup = m_pBlockSizeLookup + t * (kMaxBlockSize + 1);
+            size_t j = 0;
+            for (size_t i = 0; i <= kMaxBlockSize; i++)
+            {
+                if (i > block_sizes[j]) ++j;
+                lookup[i] = base + j;
+            }
+
+            // initialize the allocators
+            for (size_t i = 0; i < block_sizes.size(); i++)
+            {
+                m_pAllocators[base + i].Reset(block_sizes[i], s_PageSize, alignment);
+                m_pAllocators[base + i].SetPageOwner(static_cast<uint16_t>(base + i));
+            }
+            base += block_sizes.size();
         }
+        RK_CORE_ASSERT(base == s_NumBlockSizes, "Size Class Table Error");
 
-        // initialize the allocators
-        m_pAllocators = new BlockAllocator[kNumBlockSizes];
-        for (size_t i = 0; i < kNumBlockSizes; i++)
+        s_bRecording = !m_RecordFile.empty();
+        if (s_bRecording)
         {
-            m_pAllocators[i].Reset(kBlockSizes[i], kPageSize, kAlignment);
+            for (auto& row : s_SizeHistogram)
+                for (auto& count : row)
+                    count.store(0, std::memory_order_relaxed);
         }
 
-        s_bInitialized = true;
+        s_Generation.fetch_add(1, std::memory_order_release);
     }
 
     return 0; 
@@ -71,81 +429,364 @@ int MemoryManager::Initialize()
 
 void MemoryManager::Finalize() 
 { 
+    // other threads must be joined by now, only our own cache is left
+    t_ThreadCache.FlushAll();
+
+#if defined(RK_MEMORY_TRACKING)
+    ReportLeaks();
+#endif
+    if (s_bRecording)
+    {
+        SaveSizeHistogram(m_RecordFile);
+        s_bRecording = false;
+    }
+    if (m_pAllocators)
+    {
+        for (size_t i = 0; i < s_NumBlockSizes; ++i)
+        {
+            auto stats = m_pAllocators[i].GetStats();
+            if (stats.LiveBlocks > 0)
+                RK_CORE_WARN("Memory Manager: {} blocks of size {}:{} not freed", stats.LiveBlocks, stats.BlockSize, stats.Alignment);
+        }
+    }
+    s_Generation.fetch_add(1, std::memory_order_release);
+
     delete[] m_pAllocators;
+    delete[] m_pAllocatorMutex;
     delete[] m_pBlockSizeLookup;
+    m_pAllocators = nullptr;
+    m_pAllocatorMutex = nullptr;
+    m_pBlockSizeLookup = nullptr;
     assert(m_mapMemoryAllocationInfo.empty()); 
+    m_PageHeap.Finalize();
 }
 
 void MemoryManager::Tick(Timestep ts) 
 {
-#if defined(RK_DEBUG)
-    static float count = 0.0f;
+    Trim(kTrimBudget);
 
-    if (count >= 1000.0f)
+    m_fReleaseTimer += ts.GetSeconds();
+    if (m_fReleaseTimer >= kPageReleaseInterval)
     {
-        //RK_CORE_TRACE("Memory Manager Info:");
-        //for (auto info : m_mapMemoryAllocationInfo)
-        //{
-        //    RK_CORE_TRACE("{}\t{}:{}", info.first, info.second.PageMemoryType, info.second.PageSize);
-        //}
-        count = 0.0f;
+        ReleaseFreePages();
+        m_fReleaseTimer = 0.0f;
     }
-    else
+}
+
+size_t MemoryManager::Trim(float budget_ms)
+{
+    if (!m_pAllocators)
+        return 0;
+
+    using Clock = std::chrono::steady_clock;
+    auto deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float, std::milli>(budget_ms));
+
+    // resume where the last tick stopped so every size class gets its turn
+    size_t released = 0;
+    for (size_t visited = 0; visited < s_NumBlockSizes; ++visited)
     {
-        count += ts;
+        size_t size_class = m_nTrimCursor;
+        m_nTrimCursor = (m_nTrimCursor + 1) % s_NumBlockSizes;
+
+        // never stall a thread refilling its cache
+        std::unique_lock<std::mutex> lock(m_pAllocatorMutex[size_class], std::try_to_lock);
+        if (!lock.owns_lock())
+            continue;
+
+        size_t pages;
+        do
+        {
+            pages = m_pAllocators[size_class].Trim(kTrimBatch, kRetainedEmptyPages);
+            released += pages;
+            if (Clock::now() >= deadline)
+                return released;
+        } while (pages == kTrimBatch);
     }
-#endif
+    return released;
+}
+
+size_t MemoryManager::ReleaseFreePages()
+{
+    std::lock_guard<std::mutex> lock(m_PageMutex);
+    return m_PageHeap.ReleaseFreePages();
 }
 
-BlockAllocator* MemoryManager::LookUpAllocator(size_t size)
+Vec<MemoryManager::PageUsage> MemoryManager::GetPageUsage()
+{
+    Vec<size_t> reserved(s_NumBlockSizes);
+    Vec<size_t> resident(s_NumBlockSizes);
+    {
+        std::lock_guard<std::mutex> lock(m_PageMutex);
+        m_PageHeap.QueryUsage(reserved.data(), resident.data(), s_NumBlockSizes);
+    }
+
+    Vec<PageUsage> usage;
+    usage.reserve(s_NumBlockSizes);
+    for (size_t t = 0; t < kNumTables; ++t)
+    {
+        for (auto block_size : s_BlockSizes[t])
+        {
+            size_t size_class = usage.size();
+            usage.push_back({block_size, kDefaultSizeClassTables[t].Alignment, reserved[size_class], resident[size_class]});
+        }
+    }
+    return usage;
+}
+
+void MemoryManager::ReportPageUsage()
+{
+    size_t reserved, committed, used;
+    {
+        std::lock_guard<std::mutex> lock(m_PageMutex);
+        reserved = m_PageHeap.GetReservedBytes();
+        committed = m_PageHeap.GetCommittedBytes();
+        used = m_PageHeap.GetUsedBytes();
+    }
+    RK_CORE_TRACE("Memory Manager Info: reserved {} KB, committed {} KB, used {} KB",
+        reserved / 1024, committed / 1024, used / 1024);
+    for (const auto& usage : GetPageUsage())
+    {
+        if (usage.ReservedBytes == 0)
+            continue;
+        RK_CORE_TRACE("\t{}:{}\treserved {} KB\tresident {} KB",
+            usage.BlockSize, usage.Alignment, usage.ReservedBytes / 1024, usage.ResidentBytes / 1024);
+    }
+}
+
+size_t MemoryManager::LookUpSizeClass(size_t size, size_t alignment)
 {
     // check eligibility for lookup
-    if (size <= kMaxBlockSize)
-        return m_pAllocators + m_pBlockSizeLookup[size];
+    size_t table = LookUpTable(alignment);
+    if (size <= kMaxBlockSize && table < kNumTables)
+        return m_pBlockSizeLookup[table * (kMaxBlockSize + 1) + size];
     else
-        return nullptr;
+        return s_NumBlockSizes;
 }
 
-void* MemoryManager::Allocate(size_t size)
+void* MemoryManager::Allocate(size_t size, size_t alignment, const char* file, uint32_t line)
 {
-    BlockAllocator* pAlloc = LookUpAllocator(size);
+    size_t size_class = LookUpSizeClass(size, alignment);
     void* ptr = nullptr;
-    if (pAlloc)
-        ptr = pAlloc->Allocate();
+    if (size_class < s_NumBlockSizes)
+    {
+        ptr = t_ThreadCache.Allocate(size_class, size);
+        if (s_bRecording)
+            s_SizeHistogram[LookUpTable(alignment)][size].fetch_add(1, std::memory_order_relaxed);
+    }
     else
-        ptr = malloc(size);
+    {
+        ptr = AlignedMalloc(size, alignment);
+        s_LargeAllocations.fetch_add(1, std::memory_order_relaxed);
+        s_LargeBytes.fetch_add(size, std::memory_order_relaxed);
+    }
     //RK_CORE_TRACE("Allocate Size {}, {}", ptr, size);
+
+#if defined(RK_MEMORY_TRACKING)
+    {
+        std::lock_guard<std::mutex> lock(m_TrackingMutex);
+        m_mapLiveAllocations[ptr] = {size, alignment, file, line};
+    }
+#else
+    (void)file;
+    (void)line;
+#endif
     return ptr;
 }
 
-void MemoryManager::Free(void* p, size_t size)
+void MemoryManager::Free(void* p, size_t size, size_t alignment)
 {
     //RK_CORE_TRACE("Free Size {}, {}", p, size);
-    BlockAllocator* pAlloc = LookUpAllocator(size);
-    if (pAlloc)
-        pAlloc->Free(p);
+#if defined(RK_MEMORY_TRACKING)
+    {
+        std::lock_guard<std::mutex> lock(m_TrackingMutex);
+        auto it = m_mapLiveAllocations.find(p);
+        if (it == m_mapLiveAllocations.end())
+            RK_CORE_ERROR("Memory Manager: free of unknown pointer {}", p);
+        else if (it->second.Size != size || it->second.Alignment != alignment)
+            RK_CORE_ERROR("Memory Manager: {} allocated with {}:{} but freed with {}:{}",
+                p, it->second.Size, it->second.Alignment, size, alignment);
+        if (it != m_mapLiveAllocations.end())
+            m_mapLiveAllocations.erase(it);
+    }
+#endif
+
+    size_t size_class = LookUpSizeClass(size, alignment);
+    if (size_class < s_NumBlockSizes)
+    {
+        t_ThreadCache.Free(p, size_class, size);
+    }
     else
-        free(p);
+    {
+        AlignedFree(p, alignment);
+        s_LargeAllocations.fetch_sub(1, std::memory_order_relaxed);
+        s_LargeBytes.fetch_sub(size, std::memory_order_relaxed);
+    }
 }
 
-void* MemoryManager::AllocatePage(size_t size)
+bool MemoryManager::SaveSizeHistogram(const String& path)
 {
-    uint8_t* p;
+    std::ofstream file(path);
+    if (!file.is_open())
+    {
+        RK_CORE_WARN("Memory Manager cannot write size histogram {}", path);
+        return false;
+    }
+
+    // peak footprint of the run, lets the tool weigh page tail waste
+    size_t peak_live_bytes = 0;
+    for (const auto& size_class : GetStats().SizeClasses)
+        peak_live_bytes += size_class.PeakLiveBlocks * size_class.BlockSize;
 
-    p = static_cast<uint8_t*>(malloc(size));
+    file << "# requested size histogram, input of size_class_tool\n";
+    file << "page_size " << s_PageSize << '\n';
+    file << "peak_live_bytes " << peak_live_bytes << '\n';
+    for (size_t t = 0; t < kNumTables; ++t)
+    {
+        for (size_t size = 0; size <= kMaxBlockSize; ++size)
+        {
+            uint32_t count = s_SizeHistogram[t][size].load(std::memory_order_relaxed);
+            if (count > 0)
+                file << "size " << kDefaultSizeClassTables[t].Alignment << ' ' << size << ' ' << count << '\n';
+        }
+    }
+    RK_CORE_INFO("Memory Manager wrote size histogram {}", path);
+    return true;
+}
+
+MemoryStats MemoryManager::GetStats()
+{
+    MemoryStats stats;
+    if (!m_pAllocators)
+        return stats;
+
+    // other threads report at their next refill or flush
+    t_ThreadCache.SyncAll();
+
+    stats.SizeClasses.reserve(s_NumBlockSizes);
+    for (size_t i = 0; i < s_NumBlockSizes; ++i)
+    {
+        std::lock_guard<std::mutex> lock(m_pAllocatorMutex[i]);
+        stats.SizeClasses.push_back(m_pAllocators[i].GetStats());
+    }
+    stats.LargeAllocations = s_LargeAllocations.load(std::memory_order_relaxed);
+    stats.LargeBytes = s_LargeBytes.load(std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(m_PageMutex);
+        stats.ReservedBytes = m_PageHeap.GetReservedBytes();
+        stats.CommittedBytes = m_PageHeap.GetCommittedBytes();
+    }
+    return stats;
+}
+
+String MemoryManager::ExportStatsJson()
+{
+    auto stats = GetStats();
+    auto pages = GetPageUsage();
+
+    std::stringstream json;
+    json << "{";
+    json << "\"reserved_bytes\":" << stats.ReservedBytes << ',';
+    json << "\"committed_bytes\":" << stats.CommittedBytes << ',';
+    json << "\"large_allocations\":" << stats.LargeAllocations << ',';
+    json << "\"large_bytes\":" << stats.LargeBytes << ',';
+    json << "\"size_classes\":[";
+    for (size_t i = 0; i < stats.SizeClasses.size(); ++i)
+    {
+        const auto& size_class = stats.SizeClasses[i];
+        json << (i > 0 ? ",{" : "{");
+        json << "\"block_size\":" << size_class.BlockSize << ',';
+        json << "\"alignment\":" << size_class.Alignment << ',';
+        json << "\"pages\":" << size_class.Pages << ',';
+        json << "\"blocks\":" << size_class.Blocks << ',';
+        json << "\"live_blocks\":" << size_class.LiveBlocks << ',';
+        json << "\"peak_live_blocks\":" << size_class.PeakLiveBlocks << ',';
+        json << "\"requested_bytes\":" << size_class.RequestedBytes << ',';
+        json << "\"rounding_waste\":" << size_class.RoundingWaste() << ',';
+        json << "\"fragmentation\":" << size_class.Fragmentation() << ',';
+        json << "\"resident_bytes\":" << pages[i].ResidentBytes;
+        json << "}";
+    }
+    json << "],\"resources\":[";
+    auto resources = GetMemoryResourceStats();
+    for (size_t i = 0; i < resources.size(); ++i)
+    {
+        json << (i > 0 ? ",{" : "{");
+        json << "\"name\":\"" << resources[i].Name << "\",";
+        json << "\"allocations\":" << resources[i].Allocations << ',';
+        json << "\"live_bytes\":" << resources[i].LiveBytes << ',';
+        json << "\"peak_bytes\":" << resources[i].PeakBytes << ',';
+        json << "\"total_bytes\":" << resources[i].TotalBytes;
+        json << "}";
+    }
+    json << "]}";
+    return json.str();
+}
+
+#if defined(RK_MEMORY_TRACKING)
+void MemoryManager::ReportLeaks()
+{
+    struct CallSite
+    {
+        size_t Count = 0;
+        size_t Bytes = 0;
+    };
+
+    std::lock_guard<std::mutex> lock(m_TrackingMutex);
+    // group by call site, untagged allocations share one entry
+    Map<std::pair<String, uint32_t>, CallSite> sites;
+    for (const auto& [p, record] : m_mapLiveAllocations)
+    {
+        auto& site = sites[{record.File ? record.File : "unknown", record.Line}];
+        ++site.Count;
+        site.Bytes += record.Size;
+    }
+    for (const auto& [location, site] : sites)
+        RK_CORE_ERROR("Memory Leak: {} allocations, {} bytes from {}:{}", site.Count, site.Bytes, location.first, location.second);
+    m_mapLiveAllocations.clear();
+}
+#endif
+
+void* MemoryManager::AllocatePage(size_t size, uint16_t owner)
+{
+    std::lock_guard<std::mutex> lock(m_PageMutex);
+    // page heap pages are aligned to the page size, enough for every size class
+    void* p = m_PageHeap.AllocatePage(size, owner, MemoryType::CPU);
+    if (p)
+        return p;
+
+    // block allocators find their page by masking, keep the page size alignment
+    p = AlignedMalloc(size, s_PageSize);
     if (p) {
         MemoryAllocationInfo info = {size, MemoryType::CPU};
         m_mapMemoryAllocationInfo.insert({p, info});
     }
 
-    return static_cast<void*>(p);
+    return p;
 }
 
 void MemoryManager::FreePage(void* p)
 {
+    std::lock_guard<std::mutex> lock(m_PageMutex);
+    // owner is found from the address, no search needed
+    if (m_PageHeap.FreePage(p))
+        return;
+
     auto it = m_mapMemoryAllocationInfo.find(p);
     if (it != m_mapMemoryAllocationInfo.end()) {
         m_mapMemoryAllocationInfo.erase(it);
-        free(p);
+        AlignedFree(p, s_PageSize);
     }
 }
+
+void* Rocket::PoolAllocate(size_t size, size_t alignment)
+{
+    RK_CORE_ASSERT(MemoryManager::IsInitialized(), "Pool Allocate Before Memory Manager Initialize");
+    return g_MemoryManager->Allocate(size, alignment, "CreateRef/CreateScope", 0);
+}
+
+void Rocket::PoolFree(void* p, size_t size, size_t alignment)
+{
+    // objects released after Finalize went away with their pages
+    if (MemoryManager::IsInitialized())
+        g_MemoryManager->Free(p, size, alignment);
+}
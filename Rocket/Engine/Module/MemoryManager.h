@@ -2,29 +2,46 @@
 #pragma once
 #include "Interface/IMemoryManager.h"
 #include "Common/BlockAllocator.h"
+#include "Common/PageHeap.h"
 #include "Utils/Portable.h"
 
 #include <functional>
+#include <mutex>
 
 namespace Rocket
 {
-    ENUM(MemoryType){CPU = "CPU"_i32, GPU = "GPU"_i32};
     std::ostream& operator<<(std::ostream& out, MemoryType type);
 
+    struct MemoryStats
+    {
+        // one entry per size class, live counts lag by up to a magazine per thread
+        Vec<BlockAllocatorStats> SizeClasses;
+        // live requests too large for any size class
+        size_t LargeAllocations = 0;
+        size_t LargeBytes = 0;
+        // page heap
+        size_t ReservedBytes = 0;
+        size_t CommittedBytes = 0;
+    };
+
     class MemoryManager : implements IMemoryManager
     {
     public:
+        // alignment of the default size class table and the strictest one
+        static constexpr size_t kDefaultAlignment = 4;
+        static constexpr size_t kMaxAlignment = 64;
+
         template<typename T, typename... Arguments>
         T* New(Arguments... parameters)
         {
-            return new (Allocate(sizeof(T))) T(parameters...);
+            return new (Allocate(sizeof(T), alignof(T))) T(parameters...);
         }
 
         template<typename T>
         void Delete(T *p)
         {
             reinterpret_cast<T*>(p)->~T();
-            Free(p, sizeof(T));
+            Free(p, sizeof(T), alignof(T));
         }
 
     public:
@@ -32,15 +49,53 @@ namespace Rocket
         MemoryManager() = default;
         virtual ~MemoryManager() = default;
 
+        // size class table written by size_class_tool, empty keeps the built-in one;
+        // both have to be set before Initialize
+        void SetSizeClassFile(const String& path) { m_SizeClassFile = path; }
+        // histogram requested sizes and write them to path at Finalize
+        void SetRecordFile(const String& path) { m_RecordFile = path; }
+
         int Initialize() final;
         void Finalize() final;
         void Tick(Timestep ts) final;
+        // trims the caches of the main thread
+        void DeclareTickAccess(ModuleTickAccess& access) const final { access.Write("memory"_sid); }
 
-        void* Allocate(size_t size);
-        void  Free(void* p, size_t size);
-        void* AllocatePage(size_t size) final;
+        // alignment up to kMaxAlignment is served from pooled size classes,
+        // Free must be called with the same size and alignment
+        void* Allocate(size_t size, size_t alignment = kDefaultAlignment) { return Allocate(size, alignment, nullptr, 0); }
+        // file and line tag the allocation for leak reports, kept only with RK_MEMORY_TRACKING
+        void* Allocate(size_t size, size_t alignment, const char* file, uint32_t line);
+        void  Free(void* p, size_t size, size_t alignment = kDefaultAlignment);
+        void* AllocatePage(size_t size, uint16_t owner) final;
         void  FreePage(void* p) final;
 
+        // returns empty pages of the size classes to the page heap within
+        // budget_ms, called every Tick; returns the number of pages
+        size_t Trim(float budget_ms);
+        // returns the freed pages to the OS, done once a second from Tick
+        size_t ReleaseFreePages();
+
+        struct PageUsage
+        {
+            size_t BlockSize;
+            size_t Alignment;
+            size_t ReservedBytes;   // pages held by the size class
+            size_t ResidentBytes;   // part of them backed by physical memory
+        };
+        // one entry per size class
+        Vec<PageUsage> GetPageUsage();
+        // logs the above, on request only
+        void ReportPageUsage();
+
+        MemoryStats GetStats();
+        // stats of every size class as a json document
+        String ExportStatsJson();
+        // requested sizes seen so far in recording mode, input of size_class_tool
+        bool SaveSizeHistogram(const String& path);
+
+        static bool IsInitialized() { return m_pAllocators != nullptr; }
+
     private:
         struct MemoryAllocationInfo 
         {
@@ -48,21 +103,53 @@ namespace Rocket
             MemoryType PageMemoryType;
         };
         
+        // pages are carved from the page heap, this map only holds
+        // the few that did not fit once its region was exhausted
+        PageHeap m_PageHeap;
         Map<void*, MemoryAllocationInfo> m_mapMemoryAllocationInfo;
+        std::mutex m_PageMutex;
+        float m_fReleaseTimer = 0.0f;
+        size_t m_nTrimCursor = 0;
+        String m_SizeClassFile;
+        String m_RecordFile;
+
+#if defined(RK_MEMORY_TRACKING)
+        struct AllocationRecord
+        {
+            size_t Size;
+            size_t Alignment;
+            const char* File;
+            uint32_t Line;
+        };
+
+        void ReportLeaks();
+
+        UMap<void*, AllocationRecord> m_mapLiveAllocations;
+        std::mutex m_TrackingMutex;
+#endif
 
     private:
+        // Each size class is a shared depot guarded by its own mutex,
+        // threads only touch it when their local magazine runs dry or full
         static size_t* m_pBlockSizeLookup;
         static BlockAllocator* m_pAllocators;
+        static std::mutex* m_pAllocatorMutex;
     private:
-        static BlockAllocator* LookUpAllocator(size_t size);
+        static size_t LookUpSizeClass(size_t size, size_t alignment);
+        friend struct ThreadCache;
     };
 
     MemoryManager* GetMemoryManager();
     extern MemoryManager* g_MemoryManager;
 
-#if defined(USE_MEMORY_MANAGER)
+#if defined(USE_MEMORY_MANAGER) && defined(RK_MEMORY_TRACKING)
+#define RK_ALLOCATE(sz) g_MemoryManager->Allocate(sz, MemoryManager::kDefaultAlignment, __FILE__, __LINE__)
+#define RK_ALLOCATE_CLASS(T) g_MemoryManager->Allocate(sizeof(T), alignof(T), __FILE__, __LINE__)
+#define RK_DELETE(T,p) g_MemoryManager->Delete<T>(p)
+#define RK_FREE(p,n) g_MemoryManager->Free(p, n)
+#elif defined(USE_MEMORY_MANAGER)
 #define RK_ALLOCATE(sz) g_MemoryManager->Allocate(sz)
-#define RK_ALLOCATE_CLASS(T) g_MemoryManager->Allocate(sizeof(T))
+#define RK_ALLOCATE_CLASS(T) g_MemoryManager->Allocate(sizeof(T), alignof(T))
 #define RK_DELETE(T,p) g_MemoryManager->Delete<T>(p)
 #define RK_FREE(p,n) g_MemoryManager->Free(p, n)
 #else
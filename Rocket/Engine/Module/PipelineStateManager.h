@@ -71,6 +71,7 @@ namespace Rocket
         int Initialize() override;
         void Finalize() override;
         void Tick(Timestep ts) override {}
+        void DeclareTickAccess(ModuleTickAccess& access) const override { access.Write("graphics"_sid); }
 
         virtual bool RegisterPipelineState(PipelineState& pipelineState);
         virtual void UnregisterPipelineState(PipelineState& pipelineState);
@@ -1,7 +1,14 @@
 #include "Module/ProcessManager.h"
 
+#include <algorithm>
+
 using namespace Rocket;
 
+// any thread fibers resumed per job
+static const size_t kFiberGrain = 8;
+// parallel processes updated per job
+static const size_t kParallelGrain = 256;
+
 ProcessManager* Rocket::GetProcessManager() { return new ProcessManager(); }
 
 int ProcessManager::Initialize()
@@ -12,7 +19,16 @@ int ProcessManager::Initialize()
 void ProcessManager::Finalize()
 {
     AbortAllProcesses(true);
-    m_ProcessList.clear();
+    // the ones not alive were left, whoever still holds them
+    for (auto& pProcess : m_Running)
+        pProcess->m_pManager = nullptr;
+    m_Running.clear();
+    // scripts still suspended are dropped with their stacks
+    m_ReadyFibers.clear();
+    m_SleepingFibers.clear();
+    m_AwaitingFibers.clear();
+    m_FreeFibers.clear();
+    m_nFiberCount = 0;
 }
 
 void ProcessManager::Tick(Timestep ts)
@@ -28,73 +44,461 @@ void ProcessManager::Tick(Timestep ts)
 //---------------------------------------------------------------------------------------------------------------------
 // The process update tick.  Called every logic tick.  This function returns the number of process chains that
 // succeeded in the upper 32 bits and the number of process chains that failed or were aborted in the lower 32 bits.
+// Paused and sleeping processes are not looked at, only the ones woken since the last update.
 //---------------------------------------------------------------------------------------------------------------------
 uint64_t ProcessManager::UpdateProcesses(unsigned long deltaMs)
 {
     uint64_t successCount = 0;
     uint64_t failCount = 0;
+    m_nNowMs += deltaMs;
+
+    // unpaused, or ended while paused or sleeping
+    for (Process* pProcess : m_Woken)
+    {
+        pProcess->m_bWoken = false;
+        if (pProcess->m_nBucket == kPaused || pProcess->m_nBucket == kSleeping)
+            AddToBucket(RemoveFromBucket(pProcess));
+    }
+    m_Woken.clear();
 
-    ProcessList::iterator it = m_ProcessList.begin();
-    while (it != m_ProcessList.end())
+    while (!m_Sleeping.empty() && m_Sleeping[0].WakeTime <= m_nNowMs)
     {
-        // grab the next process
-        StrongProcessPtr pCurrProcess = (*it);
+        StrongProcessPtr pProcess = RemoveFromBucket(m_Sleeping[0].Process.get());
+        if (pProcess->GetState() == Process::SLEEPING)
+            pProcess->SetState(Process::RUNNING);
+        AddToBucket(std::move(pProcess));
+    }
 
-        // save the iterator and increment the old one in case we need to remove this process from the list
-        ProcessList::iterator thisIt = it;
-        ++it;
+    for (auto& pProcess : m_Attached)
+        AddToBucket(std::move(pProcess));
+    m_Attached.clear();
+
+    size_t i = 0;
+    while (i < m_Running.size())
+    {
+        Process* pCurrProcess = m_Running[i].get();
 
         // process is uninitialized, so initialize it
         if (pCurrProcess->GetState() == Process::UNINITIALIZED)
             pCurrProcess->OnInit();
 
-        // give the process an update tick if it's running
-        if (pCurrProcess->GetState() == Process::RUNNING)
+        // give the process an update tick if it's running, parallel ones
+        // get theirs with the others once moved
+        if (pCurrProcess->GetState() == Process::RUNNING && !pCurrProcess->m_bParallel)
             pCurrProcess->OnUpdate(deltaMs);
 
-        // check to see if the process is dead
-        if (pCurrProcess->IsDead())
+        Process::State state = pCurrProcess->GetState();
+        if ((state == Process::RUNNING && !pCurrProcess->m_bParallel) || state == Process::UNINITIALIZED || state == Process::REMOVED)
         {
-            // run the appropriate exit function
-            switch (pCurrProcess->GetState())
-            {
-            case Process::SUCCEEDED:
-            {
-                pCurrProcess->OnSuccess();
-                StrongProcessPtr pChild = pCurrProcess->RemoveChild();
-                if (pChild)
-                    AttachProcess(pChild);
-                else
-                    ++successCount; // only counts if the whole chain completed
-                break;
-            }
+            ++i;
+            continue;
+        }
 
-            case Process::FAILED:
-            {
-                pCurrProcess->OnFail();
-                ++failCount;
-                break;
-            }
+        // the last one takes its slot and is looked at next
+        StrongProcessPtr pProcess = RemoveFromBucket(pCurrProcess);
+        if (pProcess->IsDead())
+            OnProcessDead(pProcess, successCount, failCount);
+        else
+            AddToBucket(std::move(pProcess));
+    }
+
+    UpdateParallelProcesses(deltaMs, successCount, failCount);
+    UpdateFibers(successCount, failCount);
+
+    m_SuccessCount = successCount;
+    m_FailCount = failCount;
+    return (static_cast<uint64_t>(successCount << 32) | static_cast<uint64_t>(failCount));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// Updates the running parallel processes in chunks on the job system. The ones that stopped running are collected
+// and handled afterwards on this thread, in the order they are kept in.
+//---------------------------------------------------------------------------------------------------------------------
+void ProcessManager::UpdateParallelProcesses(unsigned long deltaMs, uint64_t& successCount, uint64_t& failCount)
+{
+    size_t count = m_ParallelRunning.size();
+    if (count == 0)
+        return;
+
+    m_ParallelChanged.resize(count);
+    m_nParallelChanged.store(0, std::memory_order_relaxed);
+    auto update = [this, deltaMs](size_t begin, size_t end) {
+        size_t changed = 0;
+        for (size_t i = begin; i < end; ++i)
+        {
+            Process* pProcess = m_ParallelRunning[i].get();
+            // paused or ended from outside since the last update
+            if (pProcess->GetState() == Process::RUNNING)
+                pProcess->OnUpdate(deltaMs);
+            if (pProcess->GetState() != Process::RUNNING)
+                ++changed;
+        }
+        if (changed == 0)
+            return;
+        // one atomic per chunk for the slots in m_ParallelChanged
+        size_t slot = m_nParallelChanged.fetch_add(changed, std::memory_order_relaxed);
+        for (size_t i = begin; i < end; ++i)
+        {
+            Process* pProcess = m_ParallelRunning[i].get();
+            if (pProcess->GetState() != Process::RUNNING)
+                m_ParallelChanged[slot++] = pProcess;
+        }
+    };
+    if (m_pJobSystem && count > kParallelGrain)
+        m_pJobSystem->ParallelFor(0, count, kParallelGrain, update);
+    else
+        update(0, count);
+
+    size_t changed = m_nParallelChanged.load(std::memory_order_relaxed);
+    if (changed == 0)
+        return;
+    // chunks finish in any order, keep the exit functions in a fixed one
+    std::sort(m_ParallelChanged.begin(), m_ParallelChanged.begin() + changed,
+        [](const Process* lhs, const Process* rhs) { return lhs->m_nSlot < rhs->m_nSlot; });
+    for (size_t i = 0; i < changed; ++i)
+    {
+        StrongProcessPtr pProcess = RemoveFromBucket(m_ParallelChanged[i]);
+        if (pProcess->IsDead())
+            OnProcessDead(pProcess, successCount, failCount);
+        else
+            AddToBucket(std::move(pProcess));
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// Runs the exit function of a dead process, attaches its child and wakes the fibers awaiting it.
+//---------------------------------------------------------------------------------------------------------------------
+void ProcessManager::OnProcessDead(const StrongProcessPtr& pProcess, uint64_t& successCount, uint64_t& failCount)
+{
+    // run the appropriate exit function
+    switch (pProcess->GetState())
+    {
+    case Process::SUCCEEDED:
+    {
+        pProcess->OnSuccess();
+        StrongProcessPtr pChild = pProcess->RemoveChild();
+        if (pChild)
+            AttachProcess(pChild);
+        else
+            ++successCount; // only counts if the whole chain completed
+        break;
+    }
+
+    case Process::FAILED:
+    {
+        pProcess->OnFail();
+        ++failCount;
+        break;
+    }
+
+    case Process::ABORTED:
+    {
+        pProcess->OnAbort();
+        ++failCount;
+        break;
+    }
+
+    default:
+        break;
+    }
+
+    pProcess->m_pManager = nullptr;
+    if (pProcess->m_bWoken)
+    {
+        m_Woken.erase(std::find(m_Woken.begin(), m_Woken.end(), pProcess.get()));
+        pProcess->m_bWoken = false;
+    }
+
+    if (m_AwaitingFibers.empty())
+        return;
+    auto waiting = m_AwaitingFibers.find(pProcess.get());
+    if (waiting == m_AwaitingFibers.end())
+        return;
+    for (auto& pFiber : waiting->second)
+    {
+        pFiber->m_pAwaited.reset();
+        m_ReadyFibers.push_back(std::move(pFiber));
+    }
+    m_AwaitingFibers.erase(waiting);
+}
+
+void ProcessManager::AddToBucket(StrongProcessPtr pProcess)
+{
+    switch (pProcess->GetState())
+    {
+    case Process::PAUSED:
+    {
+        pProcess->m_nBucket = kPaused;
+        pProcess->m_nSlot = static_cast<uint32_t>(m_Paused.size());
+        m_Paused.push_back(std::move(pProcess));
+        break;
+    }
+
+    case Process::SLEEPING:
+    {
+        uint32_t slot = static_cast<uint32_t>(m_Sleeping.size());
+        pProcess->m_nBucket = kSleeping;
+        pProcess->m_nSlot = slot;
+        uint64_t wakeTime = m_nNowMs + pProcess->m_nWakeTime;
+        m_Sleeping.push_back({wakeTime, std::move(pProcess)});
+        SiftUp(slot);
+        break;
+    }
+
+    // dead ones as well, the next update reaps them
+    default:
+    {
+        if (pProcess->m_bParallel && pProcess->GetState() == Process::RUNNING)
+        {
+            pProcess->m_nBucket = kParallelRunning;
+            pProcess->m_nSlot = static_cast<uint32_t>(m_ParallelRunning.size());
+            m_ParallelRunning.push_back(std::move(pProcess));
+            break;
+        }
+        pProcess->m_nBucket = kRunning;
+        pProcess->m_nSlot = static_cast<uint32_t>(m_Running.size());
+        m_Running.push_back(std::move(pProcess));
+        break;
+    }
+    }
+}
+
+StrongProcessPtr ProcessManager::RemoveFromBucket(Process* pProcess)
+{
+    StrongProcessPtr pRemoved;
+    uint32_t slot = pProcess->m_nSlot;
+    if (pProcess->m_nBucket == kSleeping)
+    {
+        pRemoved = std::move(m_Sleeping[slot].Process);
+        if (slot + 1 != m_Sleeping.size())
+        {
+            m_Sleeping[slot] = std::move(m_Sleeping.back());
+            Process* pMoved = m_Sleeping[slot].Process.get();
+            pMoved->m_nSlot = slot;
+            m_Sleeping.pop_back();
+            // the last one may belong above or below
+            SiftUp(slot);
+            SiftDown(pMoved->m_nSlot);
+        }
+        else
+        {
+            m_Sleeping.pop_back();
+        }
+    }
+    else
+    {
+        ProcessList& bucket = pProcess->m_nBucket == kPaused ? m_Paused :
+            pProcess->m_nBucket == kParallelRunning ? m_ParallelRunning : m_Running;
+        pRemoved = std::move(bucket[slot]);
+        if (slot + 1 != bucket.size())
+        {
+            bucket[slot] = std::move(bucket.back());
+            bucket[slot]->m_nSlot = slot;
+        }
+        bucket.pop_back();
+    }
+    pRemoved->m_nBucket = kNoBucket;
+    return pRemoved;
+}
+
+void ProcessManager::SiftUp(uint32_t slot)
+{
+    SleepingProcess sleeping = std::move(m_Sleeping[slot]);
+    while (slot > 0)
+    {
+        uint32_t parent = (slot - 1) / 2;
+        if (m_Sleeping[parent].WakeTime <= sleeping.WakeTime)
+            break;
+        m_Sleeping[slot] = std::move(m_Sleeping[parent]);
+        m_Sleeping[slot].Process->m_nSlot = slot;
+        slot = parent;
+    }
+    sleeping.Process->m_nSlot = slot;
+    m_Sleeping[slot] = std::move(sleeping);
+}
+
+void ProcessManager::SiftDown(uint32_t slot)
+{
+    uint32_t count = static_cast<uint32_t>(m_Sleeping.size());
+    SleepingProcess sleeping = std::move(m_Sleeping[slot]);
+    for (;;)
+    {
+        uint32_t child = slot * 2 + 1;
+        if (child >= count)
+            break;
+        if (child + 1 < count && m_Sleeping[child + 1].WakeTime < m_Sleeping[child].WakeTime)
+            ++child;
+        if (sleeping.WakeTime <= m_Sleeping[child].WakeTime)
+            break;
+        m_Sleeping[slot] = std::move(m_Sleeping[child]);
+        m_Sleeping[slot].Process->m_nSlot = slot;
+        slot = child;
+    }
+    sleeping.Process->m_nSlot = slot;
+    m_Sleeping[slot] = std::move(sleeping);
+}
+
+void ProcessManager::WakeProcess(Process* pProcess)
+{
+    std::lock_guard<std::mutex> lock(m_WokenMutex);
+    if (pProcess->m_bWoken)
+        return;
+    pProcess->m_bWoken = true;
+    m_Woken.push_back(pProcess);
+}
 
-            case Process::ABORTED:
+//---------------------------------------------------------------------------------------------------------------------
+// Resumes the fiber processes that are due, the ones sleeping or awaiting a process are not looked at.
+//---------------------------------------------------------------------------------------------------------------------
+void ProcessManager::UpdateFibers(uint64_t& successCount, uint64_t& failCount)
+{
+    WakeFibers();
+    if (m_ReadyFibers.empty())
+        return;
+
+    // the ones made ready meanwhile wait for the next update
+    FiberList& fibers = m_ResumingFibers;
+    fibers.swap(m_ReadyFibers);
+
+    size_t count = 0;
+    for (size_t i = 0; i < fibers.size(); ++i)
+    {
+        Ref<FiberProcess>& pFiber = fibers[i];
+        if (pFiber->GetState() == Process::UNINITIALIZED)
+        {
+            pFiber->OnInit();
+            if (pFiber->GetState() == Process::RUNNING)
             {
-                pCurrProcess->OnAbort();
-                ++failCount;
-                break;
+                if (m_FreeFibers.empty())
+                {
+                    pFiber->m_pFiber = CreateScope<Fiber>();
+                }
+                else
+                {
+                    pFiber->m_pFiber = std::move(m_FreeFibers.back());
+                    m_FreeFibers.pop_back();
+                }
+                pFiber->m_pFiber->Reset(&FiberProcess::Main, pFiber.get());
             }
+        }
 
-            default:
-                break;
-            }
+        // aborted while suspended, resumed once more to return
+        if (pFiber->GetState() == Process::RUNNING || (pFiber->IsDead() && pFiber->m_pFiber))
+        {
+            if (count != i)
+                fibers[count] = std::move(pFiber);
+            ++count;
+        }
+        else if (pFiber->IsDead())
+        {
+            --m_nFiberCount;
+            OnProcessDead(pFiber, successCount, failCount);
+        }
+        // paused or not started yet
+        else
+        {
+            m_ReadyFibers.push_back(std::move(pFiber));
+        }
+    }
+    fibers.resize(count);
 
-            // remove the process and destroy it
-            m_ProcessList.erase(thisIt);
+    ResumeFibers(fibers);
+
+    for (auto& pFiber : fibers)
+    {
+        if (pFiber->m_Wake == FiberProcess::Wake::Done)
+        {
+            m_FreeFibers.push_back(std::move(pFiber->m_pFiber));
+        }
+        else if (pFiber->IsDead())
+        {
+            // dead but carried on, its stack is not reused
+            pFiber->m_pFiber.reset();
+        }
+        else
+        {
+            SuspendFiber(std::move(pFiber));
+            continue;
         }
+        --m_nFiberCount;
+        OnProcessDead(pFiber, successCount, failCount);
     }
+    fibers.clear();
+}
 
-    m_SuccessCount = successCount;
-    m_FailCount = failCount;
-    return (static_cast<uint64_t>(successCount << 32) | static_cast<uint64_t>(failCount));
+void ProcessManager::ResumeFibers(FiberList& fibers)
+{
+    // any thread ones first, side by side on the job system
+    auto mainThread = std::partition(fibers.begin(), fibers.end(),
+        [](const Ref<FiberProcess>& pFiber) { return pFiber->IsAnyThread(); });
+    size_t anyThread = mainThread - fibers.begin();
+    if (m_pJobSystem && anyThread > 1)
+    {
+        m_pJobSystem->ParallelFor(0, anyThread, kFiberGrain, [&fibers](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+                fibers[i]->m_pFiber->Resume();
+        });
+    }
+    else
+    {
+        for (size_t i = 0; i < anyThread; ++i)
+            fibers[i]->m_pFiber->Resume();
+    }
+
+    for (size_t i = anyThread; i < fibers.size(); ++i)
+        fibers[i]->m_pFiber->Resume();
+}
+
+void ProcessManager::SuspendFiber(Ref<FiberProcess> pFiber)
+{
+    switch (pFiber->m_Wake)
+    {
+    case FiberProcess::Wake::Time:
+    {
+        SleepingFiber sleeping = {m_nNowMs + pFiber->m_nWakeTime, std::move(pFiber)};
+        m_SleepingFibers.push_back(std::move(sleeping));
+        std::push_heap(m_SleepingFibers.begin(), m_SleepingFibers.end());
+        break;
+    }
+
+    case FiberProcess::Wake::Process:
+    {
+        Process* pAwaited = pFiber->m_pAwaited.get();
+        if (pAwaited && !pAwaited->IsDead())
+            m_AwaitingFibers[pAwaited].push_back(std::move(pFiber));
+        else
+            m_ReadyFibers.push_back(std::move(pFiber));
+        break;
+    }
+
+    default:
+        m_ReadyFibers.push_back(std::move(pFiber));
+        break;
+    }
+}
+
+void ProcessManager::WakeFibers()
+{
+    while (!m_SleepingFibers.empty() && m_SleepingFibers.front().WakeTime <= m_nNowMs)
+    {
+        std::pop_heap(m_SleepingFibers.begin(), m_SleepingFibers.end());
+        m_ReadyFibers.push_back(std::move(m_SleepingFibers.back().Process));
+        m_SleepingFibers.pop_back();
+    }
+}
+
+template<typename Fn>
+void ProcessManager::ForEachFiber(Fn&& fn)
+{
+    for (auto& pFiber : m_ReadyFibers)
+        fn(pFiber);
+    for (auto& sleeping : m_SleepingFibers)
+        fn(sleeping.Process);
+    for (auto& waiting : m_AwaitingFibers)
+    {
+        for (auto& pFiber : waiting.second)
+            fn(pFiber);
+    }
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -102,7 +506,18 @@ uint64_t ProcessManager::UpdateProcesses(unsigned long deltaMs)
 //---------------------------------------------------------------------------------------------------------------------
 WeakProcessPtr ProcessManager::AttachProcess(StrongProcessPtr pProcess)
 {
-    m_ProcessList.push_front(pProcess);
+    // fiber processes are kept apart, by what they wait for
+    if (auto pFiber = std::dynamic_pointer_cast<FiberProcess>(pProcess))
+    {
+        m_ReadyFibers.push_back(std::move(pFiber));
+        ++m_nFiberCount;
+    }
+    else
+    {
+        pProcess->m_pManager = this;
+        pProcess->m_bParallel = dynamic_cast<ParallelProcess*>(pProcess.get()) != nullptr;
+        m_Attached.push_back(pProcess);
+    }
     return WeakProcessPtr(pProcess);
 }
 
@@ -112,49 +527,130 @@ WeakProcessPtr ProcessManager::AttachProcess(StrongProcessPtr pProcess)
 //---------------------------------------------------------------------------------------------------------------------
 void ProcessManager::AbortAllProcesses(bool immediate)
 {
-    ProcessList::iterator it = m_ProcessList.begin();
-    while (it != m_ProcessList.end())
+    // all of them end up running, where the next update reaps the dead
+    ProcessList processes;
+    processes.swap(m_Attached);
+    for (ProcessList* bucket : {&m_Running, &m_ParallelRunning, &m_Paused})
     {
-        ProcessList::iterator tempIt = it;
-        ++it;
+        for (auto& pProcess : *bucket)
+            processes.push_back(std::move(pProcess));
+        bucket->clear();
+    }
+    for (auto& sleeping : m_Sleeping)
+        processes.push_back(std::move(sleeping.Process));
+    m_Sleeping.clear();
+    for (Process* pProcess : m_Woken)
+        pProcess->m_bWoken = false;
+    m_Woken.clear();
 
-        StrongProcessPtr pProcess = *tempIt;
+    for (auto& pProcess : processes)
+    {
         if (pProcess->IsAlive())
         {
             pProcess->SetState(Process::ABORTED);
             if (immediate)
             {
                 pProcess->OnAbort();
-                m_ProcessList.erase(tempIt);
+                pProcess->m_nBucket = kNoBucket;
+                pProcess->m_pManager = nullptr;
+                continue;
             }
         }
+        AddToBucket(std::move(pProcess));
+    }
+
+    // waits end early on abort, every suspended script is resumed next
+    ForEachFiber([](const Ref<FiberProcess>& pFiber) {
+        if (pFiber->IsAlive())
+            pFiber->SetState(Process::ABORTED);
+    });
+    for (auto& sleeping : m_SleepingFibers)
+        m_ReadyFibers.push_back(std::move(sleeping.Process));
+    m_SleepingFibers.clear();
+    for (auto& waiting : m_AwaitingFibers)
+    {
+        for (auto& pFiber : waiting.second)
+        {
+            pFiber->m_pAwaited.reset();
+            m_ReadyFibers.push_back(std::move(pFiber));
+        }
+    }
+    m_AwaitingFibers.clear();
+
+    if (!immediate)
+        return;
+    // give the scripts their chance to return now, on this thread
+    FiberList fibers;
+    fibers.swap(m_ReadyFibers);
+    for (auto& pFiber : fibers)
+    {
+        if (pFiber->GetState() != Process::ABORTED)
+        {
+            m_ReadyFibers.push_back(std::move(pFiber));
+            continue;
+        }
+        if (pFiber->m_pFiber)
+        {
+            pFiber->m_pFiber->Resume();
+            if (pFiber->m_Wake == FiberProcess::Wake::Done)
+                m_FreeFibers.push_back(std::move(pFiber->m_pFiber));
+            else
+                pFiber->m_pFiber.reset();
+        }
+        pFiber->OnAbort();
+        --m_nFiberCount;
     }
 }
 
 void ProcessManager::PauseAllProcesses()
 {
-    ProcessList::iterator it = m_ProcessList.begin();
-    while (it != m_ProcessList.end())
+    for (auto& pProcess : m_Attached)
     {
-        StrongProcessPtr pProcess = *it;
-        if (pProcess->IsAlive())
+        if (pProcess->GetState() == Process::RUNNING)
+            pProcess->Pause();
+    }
+    for (ProcessList* bucket : {&m_Running, &m_ParallelRunning})
+    {
+        size_t i = 0;
+        while (i < bucket->size())
         {
+            Process* pProcess = (*bucket)[i].get();
+            if (pProcess->GetState() != Process::RUNNING)
+            {
+                ++i;
+                continue;
+            }
             pProcess->Pause();
+            AddToBucket(RemoveFromBucket(pProcess));
         }
-        ++it;
     }
+
+    ForEachFiber([](const Ref<FiberProcess>& pFiber) {
+        if (pFiber->GetState() == Process::RUNNING)
+            pFiber->Pause();
+    });
 }
 
 void ProcessManager::UnPauseAllProcesses()
 {
-    ProcessList::iterator it = m_ProcessList.begin();
-    while (it != m_ProcessList.end())
+    for (auto& pProcess : m_Attached)
     {
-        StrongProcessPtr pProcess = *it;
-        if (pProcess->IsAlive())
-        {
-            pProcess->UnPause();
-        }
-        ++it;
+        if (pProcess->IsPaused())
+            pProcess->SetState(Process::RUNNING);
     }
+    // the woken ones are moved on the next update, the rest here
+    ProcessList paused;
+    paused.swap(m_Paused);
+    for (auto& pProcess : paused)
+    {
+        if (pProcess->IsPaused())
+            pProcess->SetState(Process::RUNNING);
+        pProcess->m_nBucket = kNoBucket;
+        AddToBucket(std::move(pProcess));
+    }
+
+    ForEachFiber([](const Ref<FiberProcess>& pFiber) {
+        if (pFiber->IsPaused())
+            pFiber->UnPause();
+    });
 }
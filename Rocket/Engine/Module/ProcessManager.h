@@ -1,13 +1,15 @@
 #pragma once
 #include "Interface/IRuntimeModule.h"
-#include "Process/Process.h"
+#include "Process/FiberProcess.h"
+#include "Utils/JobSystem.h"
 
-#include <list>
+#include <mutex>
 
 namespace Rocket
 {
     class ProcessManager : implements IRuntimeModule
     {
+        friend class Process;
     public:
         RUNTIME_MODULE_TYPE(ProcessManager);
         ProcessManager() = default;
@@ -17,6 +19,8 @@ namespace Rocket
         virtual void Finalize() override;
 
         virtual void Tick(Timestep ts) override;
+        // processes may touch anything in the scene
+        virtual void DeclareTickAccess(ModuleTickAccess& access) const override { access.Write("process"_sid).Write("scene"_sid); }
 
         // interface
         uint64_t UpdateProcesses(unsigned long deltaMs);         // updates all attached processes
@@ -24,12 +28,82 @@ namespace Rocket
         void AbortAllProcesses(bool immediate);
         void PauseAllProcesses();
         void UnPauseAllProcesses();
+        // parallel processes and fiber processes constructed any_thread are
+        // updated on it
+        void SetJobSystem(JobSystem* jobs) { m_pJobSystem = jobs; }
 
         // accessors
-        uint32_t GetProcessCount(void) const { return m_ProcessList.size(); }
+        uint32_t GetProcessCount(void) const
+        {
+            return static_cast<uint32_t>(m_Attached.size() + m_Running.size() + m_ParallelRunning.size() +
+                m_Paused.size() + m_Sleeping.size()) + m_nFiberCount;
+        }
     private:
-        typedef std::list<StrongProcessPtr> ProcessList;
-        ProcessList m_ProcessList;
+        using ProcessList = Vec<StrongProcessPtr>;
+        using FiberList = Vec<Ref<FiberProcess>>;
+
+        enum Bucket : uint8_t
+        {
+            kNoBucket = 0,
+            kRunning,   // and the ones not initialized yet
+            kParallelRunning,
+            kPaused,
+            kSleeping,
+        };
+
+        struct SleepingProcess
+        {
+            uint64_t WakeTime;
+            StrongProcessPtr Process;
+        };
+
+        struct SleepingFiber
+        {
+            uint64_t WakeTime;
+            Ref<FiberProcess> Process;
+            // earliest on top of the heap
+            bool operator<(const SleepingFiber& rhs) const { return WakeTime > rhs.WakeTime; }
+        };
+
+        void UpdateParallelProcesses(unsigned long deltaMs, uint64_t& successCount, uint64_t& failCount);
+        void UpdateFibers(uint64_t& successCount, uint64_t& failCount);
+        void ResumeFibers(FiberList& fibers);
+        void SuspendFiber(Ref<FiberProcess> process);
+        void WakeFibers();
+        void OnProcessDead(const StrongProcessPtr& pProcess, uint64_t& successCount, uint64_t& failCount);
+        void AddToBucket(StrongProcessPtr pProcess);
+        StrongProcessPtr RemoveFromBucket(Process* pProcess);
+        void SiftUp(uint32_t slot);
+        void SiftDown(uint32_t slot);
+        // called by a process leaving PAUSED or SLEEPING
+        void WakeProcess(Process* pProcess);
+        template<typename Fn>
+        void ForEachFiber(Fn&& fn);
+
+        // Processes bucketed by state in arrays, an update only walks the
+        // running ones. A process knows its bucket and slot, leaving a
+        // bucket swaps the last one into its place
+        ProcessList m_Attached;     // since the last update
+        ProcessList m_Running;
+        ProcessList m_ParallelRunning;
+        ProcessList m_Paused;
+        Vec<SleepingProcess> m_Sleeping; // min-heap on WakeTime
+        Vec<Process*> m_Woken;      // woken in place, moved by the next update
+        std::mutex m_WokenMutex;    // any thread fibers may end or unpause others
+        // parallel processes no longer running after their update
+        Vec<Process*> m_ParallelChanged;
+        std::atomic<size_t> m_nParallelChanged{0};
+        // fiber processes by what they wait for, ready ones resume next tick
+        FiberList m_ReadyFibers;
+        FiberList m_ResumingFibers;
+        Vec<SleepingFiber> m_SleepingFibers;
+        UMap<Process*, FiberList> m_AwaitingFibers;
+        uint32_t m_nFiberCount = 0;
+        // stacks of finished fibers, for the next ones
+        Vec<Scope<Fiber>> m_FreeFibers;
+        JobSystem* m_pJobSystem = nullptr;
+        // process time, advanced by every update
+        uint64_t m_nNowMs = 0;
         uint64_t m_SuccessCount = 0;
         uint64_t m_FailCount = 0;
     };
@@ -1,6 +1,6 @@
 #pragma once
 #include "Interface/IRuntimeModule.h"
-#include "Common/Allocator.h"
+#include "Common/MemoryResource.h"
 #include "Scene/Scene.h"
 
 #include <unordered_map>
@@ -17,13 +17,15 @@ namespace Rocket
         int Initialize() final;
         void Finalize() final;
         void Tick(Timestep ts) final;
+        // main thread, components are listed into the frame arena
+        void DeclareTickAccess(ModuleTickAccess& access) const final { access.Write("scene"_sid); }
 
         [[nodiscard]] bool AddScene(Ref<Scene> scene);
         [[nodiscard]] bool RemoveScene(const String& name);
         [[nodiscard]] Ref<Scene>& GetActiveScene() { return m_ActiveScene; }
         [[nodiscard]] bool SetActiveScene(const String& name);
     private:
-        UMap<uint64_t, Ref<Scene>> m_SceneList;
+        pmr::UMap<uint64_t, Ref<Scene>> m_SceneList{Scene::GetMemoryResource()};
         Ref<Scene> m_ActiveScene;
     };
 
@@ -3,6 +3,7 @@
 #if defined(PLATFORM_WINDOWS) || defined(PLATFORM_APPLE) || defined(PLATFORM_LINUX)
 #include "GLFWWindow/WindowImplement.h"
 #endif
+#include "Headless/HeadlessWindow.h"
 
 using namespace Rocket;
 
@@ -16,10 +17,16 @@ int WindowManager::Initialize()
     prop.Title = config->GetConfigInfo<String>("Graphics", "window_title");
     prop.Width = config->GetConfigInfo<uint32_t>("Graphics", "window_width");
     prop.Height = config->GetConfigInfo<uint32_t>("Graphics", "window_height");
+    // no display needed, e.g. benchmarks on a server
+    m_Headless = config->HasConfigInfo("Graphics", "headless") && config->GetConfigInfo<bool>("Graphics", "headless");
+    if (m_Headless)
+        m_Window = CreateRef<HeadlessWindow>(prop);
 #if defined(PLATFORM_WINDOWS) || defined(PLATFORM_APPLE) || defined(PLATFORM_LINUX)
-    m_Window = CreateRef<WindowImplement>(prop);
+    else
+        m_Window = CreateRef<WindowImplement>(prop);
 #else
-	RK_CORE_ASSERT(false, "Unknown platform!");
+    else
+	    RK_CORE_ASSERT(false, "Unknown platform!");
 #endif
     m_Window->Initialize();
 
@@ -31,9 +38,9 @@ void WindowManager::Finalize()
     m_Window->Finalize();
 }
 
-bool WindowManager::OnWindowResize(EventPtr& e)
+bool WindowManager::OnWindowResize(const WindowResize& e)
 {
-    m_Window->SetWidth(e->GetUInt32(1));
-    m_Window->SetHeight(e->GetUInt32(2));
+    m_Window->SetWidth(e.Width);
+    m_Window->SetHeight(e.Height);
     return false;
 }
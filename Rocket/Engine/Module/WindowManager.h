@@ -2,6 +2,7 @@
 #include "Interface/IRuntimeModule.h"
 #include "Common/Window.h"
 #include "Event/Event.h"
+#include "Event/InputEvents.h"
 
 namespace Rocket
 {
@@ -16,16 +17,19 @@ namespace Rocket
         virtual void Finalize() final;
 
         virtual void Tick(Timestep ts) final {}
+        virtual void DeclareTickAccess(ModuleTickAccess& access) const final { access.Independent().AnyThread(); }
 
-        bool OnWindowResize(EventPtr& e);
+        bool OnWindowResize(const WindowResize& e);
 
         uint32_t GetWindowWidth() { return m_Window->GetWidth(); }
         uint32_t GetWindowHeight() { return m_Window->GetHeight(); }
 
         const Ref<Window> GetWindow() { return m_Window; }
         void* GetNativeWindow() { return m_Window->GetNativeWindow(); }
+        bool IsHeadless() const { return m_Headless; }
     private:
         Ref<Window> m_Window;
+        bool m_Headless = false;
     };
 
     WindowManager* GetWindowManager();
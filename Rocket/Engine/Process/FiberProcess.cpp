@@ -0,0 +1,37 @@
+#include "Process/FiberProcess.h"
+
+using namespace Rocket;
+
+bool FiberProcess::Yield(void)
+{
+    return Suspend(Wake::Tick);
+}
+
+bool FiberProcess::WaitFor(uint64_t ms)
+{
+    // the manager adds its clock, the script may be on another thread
+    m_nWakeTime = ms;
+    return Suspend(Wake::Time);
+}
+
+bool FiberProcess::Await(StrongProcessPtr process)
+{
+    m_pAwaited = std::move(process);
+    return Suspend(Wake::Process);
+}
+
+bool FiberProcess::Suspend(Wake wake)
+{
+    m_Wake = wake;
+    m_pFiber->Yield();
+    return GetState() != ABORTED;
+}
+
+void FiberProcess::Main(void* data)
+{
+    FiberProcess* process = static_cast<FiberProcess*>(data);
+    process->Run();
+    if (process->IsAlive())
+        process->Succeed();
+    process->m_Wake = Wake::Done;
+}
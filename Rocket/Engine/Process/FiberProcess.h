@@ -0,0 +1,64 @@
+#pragma once
+#include "Process/Process.h"
+#include "Utils/Fiber.h"
+
+// winbase.h has a Yield() macro
+#if defined(PLATFORM_WINDOWS) && defined(Yield)
+#undef Yield
+#endif
+
+namespace Rocket
+{
+    //---------------------------------------------------------------------------------------------------------------------
+    // FiberProcess class
+    //
+    // A process written as one straight function instead of a state machine over OnUpdate calls. Run() executes on a
+    // fiber and suspends itself with Yield(), WaitFor() or Await(); returning from it succeeds the process unless it
+    // called Fail(). The process manager only looks at a suspended process again once it is due, so a sleeping or
+    // waiting script costs nothing per tick. A resume is a stack switch in user space, some tens of nanoseconds on
+    // x86-64 and Windows; other targets switch with ucontext, about a microsecond as it saves the signal mask.
+    //		- Every wait returns false once the process was aborted, Run() should return then. A script that keeps
+    //		  going is dropped with its stack, destructors of what it holds there do not run.
+    //		- Constructed with any_thread, the process may be resumed on a job worker alongside other such processes.
+    //		  Its Run() then touches its own state only, or synchronizes. Ending, pausing or unpausing other processes
+    //		  is fine as long as no other script does so to the same one in that tick.
+    //---------------------------------------------------------------------------------------------------------------------
+    class FiberProcess : public Process
+    {
+        friend class ProcessManager;
+    public:
+        explicit FiberProcess(bool any_thread = false) : m_bAnyThread(any_thread) {}
+
+        bool IsAnyThread(void) const { return m_bAnyThread; }
+
+    protected:
+        virtual void Run(void) = 0;
+
+        // until the next tick
+        bool Yield(void);
+        // at least ms of process time
+        bool WaitFor(uint64_t ms);
+        // until process is dead. A process never attached never wakes the waiter
+        bool Await(StrongProcessPtr process);
+
+    private:
+        enum class Wake : uint8_t
+        {
+            Tick,
+            Time,
+            Process,
+            Done,
+        };
+
+        // never called, the manager resumes the fiber instead
+        virtual void OnUpdate(unsigned long deltaMs) final {}
+        bool Suspend(Wake wake);
+        static void Main(void* process);
+
+        Scope<Fiber> m_pFiber;
+        StrongProcessPtr m_pAwaited;
+        uint64_t m_nWakeTime = 0;
+        Wake m_Wake = Wake::Tick;
+        bool m_bAnyThread;
+    };
+} // namespace Rocket
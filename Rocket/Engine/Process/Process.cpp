@@ -1,4 +1,5 @@
 #include "Process/Process.h"
+#include "Module/ProcessManager.h"
 
 using namespace Rocket;
 
@@ -27,3 +28,9 @@ StrongProcessPtr Process::RemoveChild(void)
 
     return StrongProcessPtr();
 }
+
+void Process::Wake(void)
+{
+    if (m_pManager)
+        m_pManager->WakeProcess(this);
+}
@@ -4,6 +4,9 @@
 namespace Rocket
 {
     class Process;
+    class ProcessManager;
+    // create processes with CreatePooledRef<T>(...) (Common/ObjectPool.h), they
+    // keep weak references and are recycled through the pool of their type
     using StrongProcessPtr = Ref<Process>;
     using WeakProcessPtr = StoreRef<Process>;
 
@@ -32,8 +35,9 @@ namespace Rocket
                                // this can happen when a process that is already running is parented to another process
 
             // Living processes
-            RUNNING, // initialized and running
-            PAUSED,  // initialized but paused
+            RUNNING,  // initialized and running
+            PAUSED,   // initialized but paused
+            SLEEPING, // initialized, running again once its sleep is over
 
             // Dead processes
             SUCCEEDED, // completed successfully
@@ -45,6 +49,14 @@ namespace Rocket
         State m_state;             // the current state of the process
         StrongProcessPtr m_pChild; // the child process, if any
 
+        // where the process manager keeps it, see ProcessManager
+        ProcessManager* m_pManager = nullptr;
+        uint64_t m_nWakeTime = 0;  // sleep length, then the time it ends
+        uint32_t m_nSlot = 0;      // index in its bucket
+        uint8_t m_nBucket = 0;
+        bool m_bWoken = false;
+        bool m_bParallel = false;  // a ParallelProcess
+
     public:
         // construction
         Process(void);
@@ -66,10 +78,12 @@ namespace Rocket
         // pause
         inline void Pause(void);
         inline void UnPause(void);
+        // no updates for ms of process time, typically called from OnUpdate
+        inline void SleepFor(unsigned long ms);
 
         // accessors
         State GetState(void) const { return m_state; }
-        bool IsAlive(void) const { return (m_state == RUNNING || m_state == PAUSED); }
+        bool IsAlive(void) const { return (m_state == RUNNING || m_state == PAUSED || m_state == SLEEPING); }
         bool IsDead(void) const { return (m_state == SUCCEEDED || m_state == FAILED || m_state == ABORTED); }
         bool IsRemoved(void) const { return (m_state == REMOVED); }
         bool IsPaused(void) const { return m_state == PAUSED; }
@@ -81,6 +95,23 @@ namespace Rocket
 
     private:
         void SetState(State newState) { m_state = newState; }
+        // leaving PAUSED or SLEEPING, the manager does not look at those by itself
+        void Wake(void);
+    };
+
+    //---------------------------------------------------------------------------------------------------------------------
+    // ParallelProcess class
+    //
+    // A process whose OnUpdate() touches nothing but its own state, like timers, tweens and fades. The process
+    // manager updates these in chunks side by side on the job system. OnUpdate() may end, pause or sleep its own
+    // process, not any other. OnInit(), OnSuccess(), OnFail(), OnAbort() and attaching the child still happen on the
+    // updating thread, one after another once the chunks are done.
+    //---------------------------------------------------------------------------------------------------------------------
+    class ParallelProcess : public Process
+    {
+    protected:
+        // called from any thread
+        virtual void OnUpdate(unsigned long deltaMs) override = 0;
     };
 
     //---------------------------------------------------------------------------------------------------------------------
@@ -88,14 +119,20 @@ namespace Rocket
     //---------------------------------------------------------------------------------------------------------------------
     inline void Process::Succeed(void)
     {
-        RK_CORE_ASSERT(m_state == RUNNING || m_state == PAUSED, "Process Success");
+        RK_CORE_ASSERT(m_state == RUNNING || m_state == PAUSED || m_state == SLEEPING, "Process Success");
+        State old = m_state;
         m_state = SUCCEEDED;
+        if (old != RUNNING)
+            Wake();
     }
 
     inline void Process::Fail(void)
     {
-        RK_CORE_ASSERT(m_state == RUNNING || m_state == PAUSED, "Process Fail");
+        RK_CORE_ASSERT(m_state == RUNNING || m_state == PAUSED || m_state == SLEEPING, "Process Fail");
+        State old = m_state;
         m_state = FAILED;
+        if (old != RUNNING)
+            Wake();
     }
 
     inline void Process::AttachChild(StrongProcessPtr pChild)
@@ -117,8 +154,22 @@ namespace Rocket
     inline void Process::UnPause(void)
     {
         if (m_state == PAUSED)
+        {
             m_state = RUNNING;
+            Wake();
+        }
         else
             RK_CORE_WARN("Attempting to unpause a process that isn't paused");
     }
+
+    inline void Process::SleepFor(unsigned long ms)
+    {
+        if (m_state == RUNNING)
+        {
+            m_state = SLEEPING;
+            m_nWakeTime = ms;
+        }
+        else
+            RK_CORE_WARN("Attempting to sleep a process that isn't running");
+    }
 } // namespace Rocket
\ No newline at end of file
@@ -32,7 +32,6 @@ namespace Rocket
 	private:
 		void UpdateTransform();
 	private:
-		// TODO : fix eigen3 matrix aligement issue in memory manager
 		Matrix4f m_WorldTransform = Matrix4f::Identity();
 		Quaternionf m_Orientation = Quaternionf::Identity();
 		Vector3f m_Translation = Vector3f({ 0.0f, 0.0f, 0.0f });
@@ -7,6 +7,12 @@
 using namespace xg;
 using namespace Rocket;
 
+std::pmr::memory_resource* Scene::GetMemoryResource()
+{
+    static PoolMemoryResource s_Resource("Scene");
+    return &s_Resource;
+}
+
 void Scene::OnViewportResize(uint32_t width, uint32_t height)
 {
 	m_ViewportWidth = width;
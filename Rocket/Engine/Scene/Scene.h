@@ -1,6 +1,8 @@
 #pragma once
 #include "Core/Core.h"
 #include "Utils/Timestep.h"
+#include "Common/FrameArena.h"
+#include "Common/MemoryResource.h"
 #include "Scene/SceneComponent.h"
 #include "Scene/SceneNode.h"
 
@@ -19,6 +21,9 @@ namespace Rocket
         Scene(const String& name) : m_Name(name) {}
         ~Scene() = default;
 
+        // resource of scene containers, shared with SceneManager
+        static std::pmr::memory_resource* GetMemoryResource();
+
         void OnUpdateRuntime(Timestep ts);
 		void OnUpdateEditor(Timestep ts);
 		void OnViewportResize(uint32_t width, uint32_t height);
@@ -55,10 +60,11 @@ namespace Rocket
 			SetComponents(typeid(T), {});
 		}
 
+		// result lives in the current frame arena
 		template <class T>
-		Vec<T*> GetComponents() const
+		FrameVec<T*> GetComponents() const
 		{
-			Vec<T*> result;
+			FrameVec<T*> result(FrameAllocator<T*>::Current());
 			if (HasComponent(typeid(T)))
 			{
 				auto& scene_components = GetComponents(typeid(T));
@@ -113,7 +119,7 @@ namespace Rocket
 
         SceneNode* m_Root = nullptr;
         Vec<Scope<SceneNode>> m_Nodes;
-        UMap<std::type_index, Vec<Scope<SceneComponent>>> m_Components;
+        pmr::UMap<std::type_index, Vec<Scope<SceneComponent>>> m_Components{GetMemoryResource()};
 
         friend class SceneSerializer;
     };
@@ -0,0 +1,226 @@
+#include "Utils/Fiber.h"
+#include "Core/Core.h"
+
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+#if defined(RK_FIBER_TSAN)
+#include <sanitizer/tsan_interface.h>
+#endif
+
+#if defined(PLATFORM_WINDOWS)
+#include <windows.h>
+#undef Yield
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace Rocket;
+
+#if defined(RK_FIBER_ASM_SWITCH)
+// System V x86-64: pushes the callee saved registers and the SSE / x87
+// control words on the current stack, stores the stack pointer to *from,
+// then pops the same from stack `to` and returns into it. A new fiber's
+// stack is laid out so that this returns into rk_fiber_start with the
+// fiber in r12 and Fiber::Main in r13
+#if defined(PLATFORM_APPLE)
+#define RK_FIBER_SYMBOL(name) "_" #name
+#define RK_FIBER_HIDDEN(name) ".private_extern " RK_FIBER_SYMBOL(name) "\n"
+#else
+#define RK_FIBER_SYMBOL(name) #name
+#define RK_FIBER_HIDDEN(name) ".hidden " RK_FIBER_SYMBOL(name) "\n"
+#endif
+
+extern "C" void rk_fiber_switch(void** from, void* to);
+extern "C" void rk_fiber_start();
+
+asm(
+    ".text\n"
+    ".globl " RK_FIBER_SYMBOL(rk_fiber_switch) "\n"
+    RK_FIBER_HIDDEN(rk_fiber_switch)
+    ".p2align 4\n"
+    RK_FIBER_SYMBOL(rk_fiber_switch) ":\n"
+    "    pushq %rbp\n"
+    "    pushq %rbx\n"
+    "    pushq %r12\n"
+    "    pushq %r13\n"
+    "    pushq %r14\n"
+    "    pushq %r15\n"
+    "    subq $8, %rsp\n"
+    "    stmxcsr (%rsp)\n"
+    "    fnstcw 4(%rsp)\n"
+    "    movq %rsp, (%rdi)\n"
+    "    movq %rsi, %rsp\n"
+    "    ldmxcsr (%rsp)\n"
+    "    fldcw 4(%rsp)\n"
+    "    addq $8, %rsp\n"
+    "    popq %r15\n"
+    "    popq %r14\n"
+    "    popq %r13\n"
+    "    popq %r12\n"
+    "    popq %rbx\n"
+    "    popq %rbp\n"
+    "    ret\n"
+    ".globl " RK_FIBER_SYMBOL(rk_fiber_start) "\n"
+    RK_FIBER_HIDDEN(rk_fiber_start)
+    ".p2align 4\n"
+    RK_FIBER_SYMBOL(rk_fiber_start) ":\n"
+    "    movq %r12, %rdi\n"
+    "    callq *%r13\n"
+    "    ud2\n"
+);
+#elif !defined(PLATFORM_WINDOWS)
+// makecontext passes int arguments only, the fiber starting picks itself up here
+static thread_local Fiber* s_pStarting = nullptr;
+#endif
+
+// runs entries one after another for as long as the fiber lives, Reset
+// only has to hand over the next one
+void Fiber::Main(void* data)
+{
+    Fiber* fiber = static_cast<Fiber*>(data);
+    for (;;)
+    {
+        fiber->m_Entry(fiber->m_pData);
+        fiber->m_bFinished = true;
+        fiber->Yield();
+    }
+}
+
+void Fiber::Reset(Entry entry, void* data)
+{
+    RK_CORE_ASSERT(m_bFinished, "Fiber Reset While Running");
+    m_Entry = entry;
+    m_pData = data;
+    m_bFinished = false;
+}
+
+#if defined(PLATFORM_WINDOWS)
+
+Fiber::Fiber(size_t stack_size)
+{
+    m_pFiber = CreateFiber(stack_size, [](void* data) { Fiber::Main(data); }, this);
+    if (!m_pFiber)
+        throw std::bad_alloc();
+}
+
+Fiber::~Fiber()
+{
+    if (m_pFiber)
+        DeleteFiber(m_pFiber);
+}
+
+void Fiber::Resume()
+{
+    // only fibers can switch to fibers
+    if (!IsThreadAFiber())
+        ConvertThreadToFiber(nullptr);
+    m_pCaller = GetCurrentFiber();
+    SwitchToFiber(m_pFiber);
+}
+
+void Fiber::Yield()
+{
+    SwitchToFiber(m_pCaller);
+}
+
+#else
+
+Fiber::Fiber(size_t stack_size)
+{
+    size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    stack_size = (stack_size + page - 1) / page * page;
+    m_nMappingSize = stack_size + page;
+    void* mapping = mmap(nullptr, m_nMappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED)
+        throw std::bad_alloc();
+    // stacks grow down, the lowest page is the guard
+    if (mprotect(mapping, page, PROT_NONE) != 0)
+    {
+        munmap(mapping, m_nMappingSize);
+        throw std::bad_alloc();
+    }
+    m_pMapping = static_cast<char*>(mapping);
+#if defined(RK_FIBER_TSAN)
+    m_pTsanFiber = __tsan_create_fiber(0);
+#endif
+
+#if defined(RK_FIBER_ASM_SWITCH)
+    // what rk_fiber_switch pops, from the lowest address: control words,
+    // r15, r14, r13, r12, rbx, rbp and the return address. The stack is
+    // 16 byte aligned at the call in rk_fiber_start
+    void** top = reinterpret_cast<void**>(m_pMapping + page + stack_size);
+    void** frame = top - 10;
+    uint32_t control[2] = {0x1F80, 0x037F}; // default MXCSR and x87 control word
+    memcpy(&frame[0], control, sizeof(control));
+    frame[1] = nullptr;
+    frame[2] = nullptr;
+    frame[3] = reinterpret_cast<void*>(&Fiber::Main);
+    frame[4] = this;
+    frame[5] = nullptr;
+    frame[6] = nullptr;
+    frame[7] = reinterpret_cast<void*>(&rk_fiber_start);
+    m_pContext = frame;
+#else
+    getcontext(&m_Context);
+    m_Context.uc_stack.ss_sp = m_pMapping + page;
+    m_Context.uc_stack.ss_size = stack_size;
+    m_Context.uc_link = nullptr;
+    makecontext(&m_Context, []() { Fiber::Main(s_pStarting); }, 0);
+#endif
+}
+
+Fiber::~Fiber()
+{
+#if defined(RK_FIBER_TSAN)
+    __tsan_destroy_fiber(m_pTsanFiber);
+#endif
+    if (m_pMapping)
+        munmap(m_pMapping, m_nMappingSize);
+}
+
+#if defined(RK_FIBER_ASM_SWITCH)
+
+void Fiber::Resume()
+{
+#if defined(RK_FIBER_TSAN)
+    m_pTsanCaller = __tsan_get_current_fiber();
+    __tsan_switch_to_fiber(m_pTsanFiber, 0);
+#endif
+    rk_fiber_switch(&m_pCaller, m_pContext);
+}
+
+void Fiber::Yield()
+{
+#if defined(RK_FIBER_TSAN)
+    __tsan_switch_to_fiber(m_pTsanCaller, 0);
+#endif
+    rk_fiber_switch(&m_pContext, m_pCaller);
+}
+
+#else
+
+void Fiber::Resume()
+{
+    // read by Main the first time only, before it ever yields
+    s_pStarting = this;
+#if defined(RK_FIBER_TSAN)
+    m_pTsanCaller = __tsan_get_current_fiber();
+    __tsan_switch_to_fiber(m_pTsanFiber, 0);
+#endif
+    swapcontext(&m_Caller, &m_Context);
+}
+
+void Fiber::Yield()
+{
+#if defined(RK_FIBER_TSAN)
+    __tsan_switch_to_fiber(m_pTsanCaller, 0);
+#endif
+    swapcontext(&m_Context, &m_Caller);
+}
+
+#endif
+
+#endif
@@ -0,0 +1,84 @@
+#pragma once
+#include <cstddef>
+
+#if defined(PLATFORM_WINDOWS)
+// winbase.h has a Yield() macro
+#if defined(Yield)
+#undef Yield
+#endif
+#elif defined(__x86_64__)
+// switched in user space, ucontext saves the signal mask with a syscall
+#define RK_FIBER_ASM_SWITCH
+#else
+#include <ucontext.h>
+#endif
+
+// thread sanitizer is told about every switch, or its shadow stack overflows
+#if defined(__SANITIZE_THREAD__)
+#define RK_FIBER_TSAN
+#elif defined(__has_feature)
+#if __has_feature(thread_sanitizer)
+#define RK_FIBER_TSAN
+#endif
+#endif
+
+namespace Rocket
+{
+    // A function running on a stack of its own, switched to and away from
+    // by hand. Resume runs it until it calls Yield or returns; the thread
+    // calling Resume is the one Yield goes back to, so a fiber may carry on
+    // on another thread each time. The compiler may keep the address of a
+    // thread_local across a call, code on a fiber must not use one directly
+    // on both sides of a Yield
+    class Fiber
+    {
+    public:
+        using Entry = void(*)(void* data);
+        static constexpr size_t kDefaultStackSize = 64 * 1024;
+
+        explicit Fiber(size_t stack_size = kDefaultStackSize);
+        ~Fiber();
+
+        // disable copy & assignment
+        Fiber(const Fiber& clone) = delete;
+        Fiber& operator=(const Fiber& rhs) = delete;
+
+        // entry(data) starts from the top of the stack on the next Resume.
+        // Only while not started or finished, a fiber left suspended keeps
+        // whatever its stack holds and can only be deleted
+        void Reset(Entry entry, void* data);
+        bool IsFinished() const { return m_bFinished; }
+
+        // run until it yields or finishes, not from inside itself
+        void Resume();
+        // from inside the fiber, back to where it was resumed
+        void Yield();
+
+    private:
+        static void Main(void* fiber);
+
+        Entry m_Entry = nullptr;
+        void* m_pData = nullptr;
+        bool m_bFinished = true;
+#if defined(PLATFORM_WINDOWS)
+        void* m_pFiber = nullptr;
+        void* m_pCaller = nullptr;
+#else
+#if defined(RK_FIBER_ASM_SWITCH)
+        // stack pointers saved by the switch
+        void* m_pContext = nullptr;
+        void* m_pCaller = nullptr;
+#else
+        ucontext_t m_Context;
+        ucontext_t m_Caller;
+#endif
+        // stack below a guard page, overflowing it faults
+        char* m_pMapping = nullptr;
+        size_t m_nMappingSize = 0;
+#endif
+#if defined(RK_FIBER_TSAN)
+        void* m_pTsanFiber = nullptr;
+        void* m_pTsanCaller = nullptr;
+#endif
+    };
+}
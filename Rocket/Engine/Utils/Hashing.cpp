@@ -2,34 +2,73 @@
 
 using namespace Rocket;
 
-static uint64_t _HashString_(const String& str, UMap<uint64_t, String>& id_map)
+StringIdRegistry::~StringIdRegistry()
 {
-    uint64_t result = std::hash<String>{}(str);
-    auto it = id_map.find(result);
-    if (it != id_map.end())
+    for (auto& bucket : m_Buckets)
     {
-        if (it->second == str)
+        Node* node = bucket.load(std::memory_order_relaxed);
+        while (node)
         {
-            return result;
+            Node* next = node->Next;
+            delete node;
+            node = next;
         }
-        else
+    }
+}
+
+bool StringIdRegistry::Insert(uint64_t id, const String& str)
+{
+    std::atomic<Node*>& bucket = m_Buckets[id % kBucketCount];
+    Node* head = bucket.load(std::memory_order_acquire);
+    Node* node = nullptr;
+    for (;;)
+    {
+        // nodes are only ever pushed in front, a failed CAS rescans
+        for (Node* it = head; it; it = it->Next)
         {
-            RK_CORE_ERROR("Hash String [{}] [{}] Collide", it->second, str);
-            return 0;
+            if (it->Id == id)
+            {
+                delete node;
+                return it->Str == str;
+            }
         }
+        if (!node)
+            node = new Node{id, str, nullptr};
+        node->Next = head;
+        if (bucket.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_acquire))
+            return true;
     }
-    id_map[result] = str;
-    return result;
 }
 
-static const String& _GetStringFromId_(uint64_t id, UMap<uint64_t, String>& id_map)
+const String* StringIdRegistry::Find(uint64_t id) const
 {
-    auto it = id_map.find(id);
-    if (it != id_map.end())
+    for (Node* it = m_Buckets[id % kBucketCount].load(std::memory_order_acquire); it; it = it->Next)
     {
-        return it->second;
+        if (it->Id == id)
+            return &it->Str;
     }
-    RK_CORE_ASSERT(false, "Hash String Table Don't Have String ID");
+    return nullptr;
+}
+
+static uint64_t _HashString_(const String& str, StringIdRegistry& registry)
+{
+    uint64_t result = HashStringFNV1a(str.data(), str.size());
+    if (!registry.Insert(result, str))
+    {
+        RK_CORE_ERROR("Hash String [{}] [{}] Collide", *registry.Find(result), str);
+        return 0;
+    }
+    return result;
+}
+
+static const String& _GetStringFromId_(uint64_t id, StringIdRegistry& registry)
+{
+    static const String s_Unknown = "<unknown string id>";
+    const String* result = registry.Find(id);
+    if (result)
+        return *result;
+    // ids from _sid literals are only known once HashString saw the name
+    return s_Unknown;
 }
 
 ImplementHashTable(EventHashTable);
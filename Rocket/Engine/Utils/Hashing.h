@@ -1,6 +1,7 @@
 #pragma once
 #include "Core/Core.h"
 
+#include <atomic>
 #include <string>
 #include <ostream>
 #include <functional>
@@ -38,15 +39,65 @@ namespace Rocket
         [[nodiscard]] static uint64_t Hash(const T& t) { return std::hash<T>{}(t); }
     };
 
+    // 64 bit FNV-1a, string ids of every hash table. constexpr so ids of
+    // literals are computed by the compiler
+    [[nodiscard]] constexpr uint64_t HashStringFNV1a(const char* str, size_t length)
+    {
+        uint64_t hash = 14695981039346656037ull;
+        for (size_t i = 0; i < length; ++i)
+        {
+            hash ^= static_cast<uint8_t>(str[i]);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    inline namespace Literals
+    {
+        // "key_press"_sid, same id as HashString("key_press") without the
+        // runtime hashing. The name only shows up in GetStringFromId once
+        // HashString registered it
+        constexpr uint64_t operator""_sid(const char* str, size_t length) { return HashStringFNV1a(str, length); }
+    }
+
+    // Append only id to string table. Lookups take no lock and inserts are
+    // one CAS, so names can be resolved and registered from any thread.
+    // Entries live until the table goes away
+    class StringIdRegistry
+    {
+    public:
+        StringIdRegistry() = default;
+        ~StringIdRegistry();
+        // disable copy & assignment
+        StringIdRegistry(const StringIdRegistry& clone) = delete;
+        StringIdRegistry& operator=(const StringIdRegistry& rhs) = delete;
+
+        // false when the id already belongs to another string
+        bool Insert(uint64_t id, const String& str);
+        // nullptr when the id was never inserted
+        const String* Find(uint64_t id) const;
+
+    private:
+        struct Node
+        {
+            uint64_t Id;
+            String Str;
+            Node* Next;
+        };
+
+        static constexpr size_t kBucketCount = 1024;
+        std::atomic<Node*> m_Buckets[kBucketCount] = {};
+    };
+
 #define DeclareHashTable \
     public:\
         [[nodiscard]] static uint64_t HashString(const String& str);\
         [[nodiscard]] static const String& GetStringFromId(uint64_t id);\
     protected:\
-        static UMap<uint64_t, String> IdStringMap;
+        static StringIdRegistry IdStringMap;
 
 #define ImplementHashTable(class_name) \
-    UMap<uint64_t, String> class_name::IdStringMap;\
+    StringIdRegistry class_name::IdStringMap;\
     uint64_t class_name::HashString(const String& str)\
     { uint64_t result = _HashString_(str, IdStringMap); return result; }\
     const String& class_name::GetStringFromId(uint64_t id)\
@@ -0,0 +1,260 @@
+#include "Utils/JobSystem.h"
+
+using namespace Rocket;
+
+thread_local JobSystem* JobSystem::s_pCurrentSystem = nullptr;
+thread_local uint32_t JobSystem::s_nCurrentWorker = 0;
+thread_local JobCounter* JobSystem::s_pCurrentCounter = nullptr;
+
+// empty rounds before a worker goes to sleep
+static const uint32_t kSpinRounds = 64;
+
+JobSystem::JobSystem(uint32_t num_threads)
+{
+    if (num_threads == 0)
+        num_threads = std::max(1u, std::thread::hardware_concurrency()) - 1;
+    m_nWorkerCount = num_threads + 1;
+    m_Workers.reset(new Worker[m_nWorkerCount]);
+    for (uint32_t i = 0; i < m_nWorkerCount; ++i)
+        m_Workers[i].Seed = i * 2654435761u + 1;
+
+    m_pPreviousSystem = s_pCurrentSystem;
+    m_nPreviousWorker = s_nCurrentWorker;
+    s_pCurrentSystem = this;
+    s_nCurrentWorker = 0;
+
+    for (uint32_t i = 1; i < m_nWorkerCount; ++i)
+        m_Threads.emplace_back([this, i]() { WorkerLoop(i); });
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_SleepMutex);
+        m_bStop.store(true, std::memory_order_seq_cst);
+    }
+    m_SleepCond.notify_all();
+    for (auto& thread : m_Threads)
+        thread.join();
+
+    // what is left was spawned here or handed over late
+    while (Job* job = FindJob(0))
+        Execute(job);
+
+    s_pCurrentSystem = m_pPreviousSystem;
+    s_nCurrentWorker = m_nPreviousWorker;
+
+    for (Job* block : m_Blocks)
+        delete[] block;
+}
+
+void JobSystem::Wait(JobCounter& counter)
+{
+    uint32_t worker = CurrentWorker();
+    while (!counter.IsDone())
+    {
+        Job* job = FindJob(worker);
+        if (job)
+            Execute(job);
+        else
+            std::this_thread::yield();
+    }
+}
+
+bool JobSystem::RunPendingJob()
+{
+    Job* job = FindJob(CurrentWorker());
+    if (!job)
+        return false;
+    Execute(job);
+    return true;
+}
+
+void JobSystem::Submit(Job* job)
+{
+    uint32_t worker = CurrentWorker();
+    if (worker != kExternal)
+    {
+        if (!m_Workers[worker].Deque.Push(job))
+        {
+            Execute(job);
+            return;
+        }
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(m_ExternalMutex);
+        m_External.push_back(job);
+        m_nExternal.fetch_add(1, std::memory_order_seq_cst);
+    }
+
+    // pairs with the count a worker takes before it looks for work one
+    // last time, either it sees the job or we see it sleeping
+    if (m_nSleeping.load(std::memory_order_seq_cst) > 0)
+    {
+        std::lock_guard<std::mutex> lock(m_SleepMutex);
+        m_SleepCond.notify_one();
+    }
+}
+
+void JobSystem::Execute(Job* job)
+{
+    JobCounter* counter = job->Counter;
+    JobCounter* parent = s_pCurrentCounter;
+    s_pCurrentCounter = counter;
+    job->Function(job->Data);
+    s_pCurrentCounter = parent;
+
+    FreeJob(job);
+    // children were counted before this, the counter reaches zero only
+    // once the whole tree is done
+    if (counter)
+        counter->m_nCount.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+Job* JobSystem::FindJob(uint32_t worker)
+{
+    if (worker != kExternal)
+    {
+        if (Job* job = m_Workers[worker].Deque.Pop())
+            return job;
+    }
+
+    if (m_nExternal.load(std::memory_order_relaxed) > 0)
+    {
+        std::lock_guard<std::mutex> lock(m_ExternalMutex);
+        if (!m_External.empty())
+        {
+            Job* job = m_External.front();
+            m_External.pop_front();
+            m_nExternal.fetch_sub(1, std::memory_order_relaxed);
+            return job;
+        }
+    }
+
+    // start at a random victim so thieves spread out
+    uint32_t start = 0;
+    if (worker != kExternal)
+    {
+        uint32_t& seed = m_Workers[worker].Seed;
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        start = seed % m_nWorkerCount;
+    }
+    for (uint32_t i = 0; i < m_nWorkerCount; ++i)
+    {
+        uint32_t victim = (start + i) % m_nWorkerCount;
+        if (victim == worker)
+            continue;
+        if (Job* job = m_Workers[victim].Deque.Steal())
+            return job;
+    }
+    return nullptr;
+}
+
+bool JobSystem::HasWork() const
+{
+    if (m_nExternal.load(std::memory_order_seq_cst) > 0)
+        return true;
+    for (uint32_t i = 0; i < m_nWorkerCount; ++i)
+    {
+        if (!m_Workers[i].Deque.Empty())
+            return true;
+    }
+    return false;
+}
+
+Job* JobSystem::AllocateJob()
+{
+    uint32_t worker = CurrentWorker();
+    std::unique_lock<std::mutex> lock(m_ExternalMutex, std::defer_lock);
+    Job** free_list;
+    if (worker != kExternal)
+    {
+        free_list = &m_Workers[worker].FreeList;
+        // the ones other threads ran, a plain exchange so no ABA
+        if (!*free_list)
+            *free_list = m_Workers[worker].Returned.exchange(nullptr, std::memory_order_acquire);
+    }
+    else
+    {
+        lock.lock();
+        free_list = &m_ExternalFreeList;
+    }
+
+    if (!*free_list)
+    {
+        Job* block = new Job[kJobBlock];
+        for (size_t i = 0; i < kJobBlock; ++i)
+        {
+            block[i].Next = i + 1 < kJobBlock ? &block[i + 1] : nullptr;
+            block[i].Owner = worker;
+        }
+        *free_list = block;
+        std::lock_guard<std::mutex> block_lock(m_BlockMutex);
+        m_Blocks.push_back(block);
+    }
+    Job* job = *free_list;
+    *free_list = job->Next;
+    return job;
+}
+
+// back to the thread that allocated it, a thread handing out more jobs than
+// it runs would otherwise keep allocating blocks
+void JobSystem::FreeJob(Job* job)
+{
+    uint32_t owner = job->Owner;
+    if (owner == kExternal)
+    {
+        std::lock_guard<std::mutex> lock(m_ExternalMutex);
+        job->Next = m_ExternalFreeList;
+        m_ExternalFreeList = job;
+        return;
+    }
+
+    Worker& worker = m_Workers[owner];
+    if (owner == CurrentWorker())
+    {
+        job->Next = worker.FreeList;
+        worker.FreeList = job;
+        return;
+    }
+    Job* head = worker.Returned.load(std::memory_order_relaxed);
+    do
+    {
+        job->Next = head;
+    } while (!worker.Returned.compare_exchange_weak(head, job, std::memory_order_release, std::memory_order_relaxed));
+}
+
+void JobSystem::WorkerLoop(uint32_t worker)
+{
+    s_pCurrentSystem = this;
+    s_nCurrentWorker = worker;
+
+    uint32_t idle = 0;
+    for (;;)
+    {
+        Job* job = FindJob(worker);
+        if (job)
+        {
+            Execute(job);
+            idle = 0;
+            continue;
+        }
+        if (m_bStop.load(std::memory_order_acquire))
+            break;
+        if (++idle < kSpinRounds)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_SleepMutex);
+        m_nSleeping.fetch_add(1, std::memory_order_seq_cst);
+        if (!HasWork() && !m_bStop.load(std::memory_order_seq_cst))
+            m_SleepCond.wait(lock);
+        m_nSleeping.fetch_sub(1, std::memory_order_seq_cst);
+        idle = 0;
+    }
+}
@@ -0,0 +1,246 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Rocket
+{
+    // jobs of a batch still to finish, children spawned by a job count with it
+    class JobCounter
+    {
+    public:
+        bool IsDone() const { return m_nCount.load(std::memory_order_acquire) == 0; }
+
+    private:
+        friend class JobSystem;
+        std::atomic<uint32_t> m_nCount{0};
+    };
+
+    // one cache line: the callable is stored in place, no allocation per job
+    struct alignas(64) Job
+    {
+        static constexpr size_t kDataSize = 40;
+
+        void (*Function)(void* data) = nullptr;
+        union
+        {
+            JobCounter* Counter = nullptr;
+            Job* Next;              // free list
+        };
+        uint32_t Owner = 0;         // thread whose free list it belongs to
+        alignas(void*) unsigned char Data[kDataSize];
+    };
+    static_assert(sizeof(Job) == 64, "job no longer fits a cache line");
+
+    // Chase-Lev deque after Le, Pop, Cohen and Zappa Nardelli, fixed size.
+    // The owner pushes and pops at the bottom without a CAS except for the
+    // last item, thieves take from the top with one CAS
+    class JobDeque
+    {
+    public:
+        static constexpr int64_t kCapacity = 4096;
+
+        // false when full, the owner then runs the job itself
+        bool Push(Job* job)
+        {
+            int64_t bottom = m_nBottom.load(std::memory_order_relaxed);
+            int64_t top = m_nTop.load(std::memory_order_acquire);
+            if (bottom - top >= kCapacity)
+                return false;
+            m_Jobs[bottom & (kCapacity - 1)].store(job, std::memory_order_relaxed);
+            // seq_cst pairs with the sleep check of the workers
+            m_nBottom.store(bottom + 1, std::memory_order_seq_cst);
+            return true;
+        }
+
+        // owner only, newest first
+        Job* Pop()
+        {
+            int64_t bottom = m_nBottom.load(std::memory_order_relaxed) - 1;
+            m_nBottom.store(bottom, std::memory_order_seq_cst);
+            int64_t top = m_nTop.load(std::memory_order_seq_cst);
+            if (top > bottom)
+            {
+                m_nBottom.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            Job* job = m_Jobs[bottom & (kCapacity - 1)].load(std::memory_order_relaxed);
+            if (top == bottom)
+            {
+                // the last one, race the thieves for it
+                if (!m_nTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    job = nullptr;
+                m_nBottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+            return job;
+        }
+
+        // any thread, oldest first
+        Job* Steal()
+        {
+            int64_t top = m_nTop.load(std::memory_order_seq_cst);
+            int64_t bottom = m_nBottom.load(std::memory_order_seq_cst);
+            if (top >= bottom)
+                return nullptr;
+            Job* job = m_Jobs[top & (kCapacity - 1)].load(std::memory_order_relaxed);
+            if (!m_nTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                return nullptr;
+            return job;
+        }
+
+        bool Empty() const
+        {
+            return m_nTop.load(std::memory_order_seq_cst) >= m_nBottom.load(std::memory_order_seq_cst);
+        }
+
+    private:
+        alignas(64) std::atomic<int64_t> m_nTop{0};
+        alignas(64) std::atomic<int64_t> m_nBottom{0};
+        std::atomic<Job*> m_Jobs[kCapacity];
+    };
+
+    // Work stealing job scheduler. Every worker has a JobDeque; a job
+    // spawned on a worker goes to its own deque, idle workers steal from the
+    // others, and a thread waiting on a counter runs jobs until it is done
+    // instead of blocking. The thread creating the system takes part as
+    // worker 0, other threads hand their jobs over through a locked queue.
+    // Jobs capture at most Job::kDataSize bytes, larger state goes by reference
+    class JobSystem
+    {
+    public:
+        // workers besides the creating thread, zero picks one less than the
+        // hardware has
+        explicit JobSystem(uint32_t num_threads = 0);
+        ~JobSystem();
+
+        // disable copy & assignment
+        JobSystem(const JobSystem& clone) = delete;
+        JobSystem& operator=(const JobSystem& rhs) = delete;
+
+        // run fn() on some worker, counted by counter until it finished
+        template<typename Fn>
+        void Run(JobCounter& counter, Fn&& fn) { Submit(CreateJob(std::forward<Fn>(fn), &counter)); }
+
+        // from inside a job: a child counted with its parent, so waiting for
+        // the parent waits for it as well. Outside a job nobody waits for it
+        template<typename Fn>
+        void Spawn(Fn&& fn) { Submit(CreateJob(std::forward<Fn>(fn), s_pCurrentCounter)); }
+
+        // help running jobs until counter is done
+        void Wait(JobCounter& counter);
+        // run one waiting job if there is any, for callers waiting on
+        // something other than a counter
+        bool RunPendingJob();
+
+        // fn(first, last) over [begin, end) in ranges of at most grain,
+        // split in halves on demand so idle workers steal the big halves
+        template<typename Fn>
+        void ParallelFor(size_t begin, size_t end, size_t grain, const Fn& fn)
+        {
+            if (begin >= end)
+                return;
+            JobCounter counter;
+            JobCounter* parent = s_pCurrentCounter;
+            s_pCurrentCounter = &counter;
+            Split(fn, begin, end, std::max<size_t>(grain, 1));
+            s_pCurrentCounter = parent;
+            Wait(counter);
+        }
+
+        // workers plus the creating thread
+        uint32_t GetThreadCount() const { return m_nWorkerCount; }
+
+    private:
+        static constexpr uint32_t kExternal = ~0u;
+        static constexpr size_t kJobBlock = 256;
+
+        struct alignas(64) Worker
+        {
+            JobDeque Deque;
+            Job* FreeList = nullptr;
+            uint32_t Seed = 1;
+            // its jobs freed by other threads, taken back all at once
+            alignas(64) std::atomic<Job*> Returned{nullptr};
+        };
+
+        template<typename Fn>
+        Job* CreateJob(Fn&& fn, JobCounter* counter)
+        {
+            using Callable = std::decay_t<Fn>;
+            static_assert(sizeof(Callable) <= Job::kDataSize, "job captures too much, capture by reference");
+            static_assert(alignof(Callable) <= alignof(void*), "job capture alignment not supported");
+
+            Job* job = AllocateJob();
+            new (job->Data) Callable(std::forward<Fn>(fn));
+            job->Function = [](void* data) {
+                Callable& callable = *static_cast<Callable*>(data);
+                callable();
+                callable.~Callable();
+            };
+            job->Counter = counter;
+            if (counter)
+                counter->m_nCount.fetch_add(1, std::memory_order_relaxed);
+            return job;
+        }
+
+        template<typename Fn>
+        void Split(const Fn& fn, size_t begin, size_t end, size_t grain)
+        {
+            // the far half goes to the deque, the near one is split further here
+            while (end - begin > grain)
+            {
+                size_t middle = begin + (end - begin) / 2;
+                Spawn([this, &fn, middle, end, grain]() { Split(fn, middle, end, grain); });
+                end = middle;
+            }
+            fn(begin, end);
+        }
+
+        uint32_t CurrentWorker() const { return s_pCurrentSystem == this ? s_nCurrentWorker : kExternal; }
+        void Submit(Job* job);
+        void Execute(Job* job);
+        Job* FindJob(uint32_t worker);
+        Job* AllocateJob();
+        void FreeJob(Job* job);
+        void WorkerLoop(uint32_t worker);
+        bool HasWork() const;
+
+        uint32_t m_nWorkerCount;
+        std::unique_ptr<Worker[]> m_Workers;
+        std::vector<std::thread> m_Threads;
+        std::atomic<bool> m_bStop{false};
+
+        // jobs from threads that are not workers
+        std::mutex m_ExternalMutex;
+        std::deque<Job*> m_External;
+        std::atomic<size_t> m_nExternal{0};
+        Job* m_ExternalFreeList = nullptr;
+
+        // idle workers sleep here
+        std::mutex m_SleepMutex;
+        std::condition_variable m_SleepCond;
+        std::atomic<uint32_t> m_nSleeping{0};
+
+        std::mutex m_BlockMutex;
+        std::vector<Job*> m_Blocks;
+
+        // the thread that created the system, restored when it goes away
+        JobSystem* m_pPreviousSystem;
+        uint32_t m_nPreviousWorker;
+
+        static thread_local JobSystem* s_pCurrentSystem;
+        static thread_local uint32_t s_nCurrentWorker;
+        // counter of the job running on this thread, children count with it
+        static thread_local JobCounter* s_pCurrentCounter;
+    };
+}
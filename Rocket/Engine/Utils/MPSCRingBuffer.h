@@ -0,0 +1,213 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace Rocket
+{
+    // what a producer does when the ring is full
+    enum class RingOverflow : uint8_t
+    {
+        DropOldest = 0,     // discard the oldest queued item to make room
+        Block,              // spin a while for the consumer to free a slot,
+                            // then spill, the consumer may be waiting on us
+        Spill,              // go to a locked overflow list, nothing is lost
+    };
+
+    // Bounded lock-free ring for many producers and one consumer, after
+    // Dmitry Vyukov's bounded queue: each cell carries a sequence number
+    // telling whether it is free for the producer or full for the consumer,
+    // so a push is one CAS on the enqueue position and a copy, no lock and
+    // no wakeup. Pop also claims its cell with a CAS, DropOldest producers
+    // take from the head while the consumer does.
+    template<typename T>
+    class MPSCRingBuffer
+    {
+    public:
+        explicit MPSCRingBuffer(size_t capacity = 4096, RingOverflow overflow = RingOverflow::Spill)
+        {
+            Reset(capacity, overflow);
+        }
+        // disable copy & assignment
+        MPSCRingBuffer(const MPSCRingBuffer& clone) = delete;
+        MPSCRingBuffer& operator=(const MPSCRingBuffer& rhs) = delete;
+
+        // reallocate the ring, capacity rounds up to a power of two. Queued
+        // items are lost, call before producers start
+        void Reset(size_t capacity, RingOverflow overflow)
+        {
+            size_t size = 2;
+            while (size < capacity)
+                size <<= 1;
+
+            m_Cells.reset(new Cell[size]);
+            for (size_t i = 0; i < size; ++i)
+                m_Cells[i].Sequence.store(i, std::memory_order_relaxed);
+            m_nMask = size - 1;
+            m_Overflow = overflow;
+            m_nEnqueuePos.store(0, std::memory_order_relaxed);
+            m_nDequeuePos.store(0, std::memory_order_relaxed);
+            m_nDropped.store(0, std::memory_order_relaxed);
+            m_nSpilled.store(0, std::memory_order_relaxed);
+
+            std::lock_guard<std::mutex> lock(m_SpillMutex);
+            m_Spill.clear();
+            m_Draining.clear();
+            m_nSpillSize.store(0, std::memory_order_relaxed);
+        }
+
+        // push following the overflow policy, false only when nothing
+        // was queued
+        bool Push(const T& value)
+        {
+            switch (m_Overflow)
+            {
+            case RingOverflow::DropOldest:
+                while (!TryPush(value))
+                {
+                    T oldest;
+                    if (TryPop(oldest))
+                        m_nDropped.fetch_add(1, std::memory_order_relaxed);
+                }
+                return true;
+            case RingOverflow::Block:
+                // behind what spilled the others follow, as with Spill
+                for (uint32_t spin = 0; spin < kBlockSpins; ++spin)
+                {
+                    if (m_nSpillSize.load(std::memory_order_acquire) != 0)
+                        break;
+                    if (TryPush(value))
+                        return true;
+                    std::this_thread::yield();
+                }
+                SpillPush(value);
+                return true;
+            case RingOverflow::Spill:
+                // once something spilled, later pushes follow it so the
+                // items of one producer stay in order
+                if (m_nSpillSize.load(std::memory_order_acquire) == 0 && TryPush(value))
+                    return true;
+                SpillPush(value);
+                return true;
+            }
+            return false;
+        }
+
+        // ring first, then what spilled over. Consumer thread only
+        bool Pop(T& value)
+        {
+            if (TryPop(value))
+                return true;
+            if (m_Draining.empty())
+            {
+                if (m_nSpillSize.load(std::memory_order_acquire) == 0)
+                    return false;
+                // take the whole list, one lock per batch
+                std::lock_guard<std::mutex> lock(m_SpillMutex);
+                m_Draining.swap(m_Spill);
+                if (m_Draining.empty())
+                    return false;
+            }
+            value = m_Draining.front();
+            m_Draining.pop_front();
+            // counts items until the consumer has them, producers go back
+            // to the ring only when every spilled item is out
+            m_nSpillSize.fetch_sub(1, std::memory_order_release);
+            return true;
+        }
+
+        bool TryPush(const T& value)
+        {
+            Cell* cell;
+            size_t pos = m_nEnqueuePos.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                cell = &m_Cells[pos & m_nMask];
+                size_t seq = cell->Sequence.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+                if (diff == 0)
+                {
+                    if (m_nEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                    return false;   // full
+                else
+                    pos = m_nEnqueuePos.load(std::memory_order_relaxed);
+            }
+            cell->Data = value;
+            cell->Sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool TryPop(T& value)
+        {
+            Cell* cell;
+            size_t pos = m_nDequeuePos.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                cell = &m_Cells[pos & m_nMask];
+                size_t seq = cell->Sequence.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+                if (diff == 0)
+                {
+                    if (m_nDequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                    return false;   // empty
+                else
+                    pos = m_nDequeuePos.load(std::memory_order_relaxed);
+            }
+            value = cell->Data;
+            cell->Sequence.store(pos + m_nMask + 1, std::memory_order_release);
+            return true;
+        }
+
+        size_t GetCapacity() const { return m_nMask + 1; }
+        RingOverflow GetOverflow() const { return m_Overflow; }
+        // items discarded by DropOldest and pushed to the spill list, since Reset
+        uint64_t GetDropped() const { return m_nDropped.load(std::memory_order_relaxed); }
+        uint64_t GetSpilled() const { return m_nSpilled.load(std::memory_order_relaxed); }
+
+    private:
+        // yields of a Block push before it spills, the consumer may be the
+        // pushing thread itself or waiting for it
+        static constexpr uint32_t kBlockSpins = 1024;
+
+        void SpillPush(const T& value)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_SpillMutex);
+                m_Spill.push_back(value);
+                m_nSpillSize.fetch_add(1, std::memory_order_release);
+            }
+            m_nSpilled.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        struct Cell
+        {
+            std::atomic<size_t> Sequence;
+            T Data;
+        };
+
+        std::unique_ptr<Cell[]> m_Cells;
+        size_t m_nMask = 0;
+        RingOverflow m_Overflow = RingOverflow::Spill;
+
+        // producers and consumer each own a cache line
+        alignas(64) std::atomic<size_t> m_nEnqueuePos{0};
+        alignas(64) std::atomic<size_t> m_nDequeuePos{0};
+        alignas(64) std::atomic<size_t> m_nSpillSize{0};
+        std::atomic<uint64_t> m_nDropped{0};
+        std::atomic<uint64_t> m_nSpilled{0};
+
+        std::mutex m_SpillMutex;
+        std::deque<T> m_Spill;
+        std::deque<T> m_Draining;   // consumer only
+    };
+}
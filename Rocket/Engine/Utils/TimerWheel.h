@@ -0,0 +1,208 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Rocket
+{
+    // handle of a scheduled entry, stays invalid once it fired or was cancelled
+    using TimerHandle = uint64_t;
+    constexpr TimerHandle kInvalidTimerHandle = 0;
+
+    // Hierarchical timer wheel in integer ticks, after the old Linux kernel
+    // timers: four levels of 256 slots, level n covering 256^(n+1) ticks.
+    // Insert puts an entry in the slot of its level in O(1); Advance runs the
+    // level 0 slot of every tick it passes and, when level 0 wraps, moves the
+    // next slot of the level above down. An entry moves at most three times.
+    // Entries live in one array and are linked by index. Not thread safe
+    template<typename T>
+    class TimerWheel
+    {
+    public:
+        static constexpr uint32_t kLevelBits = 8;
+        static constexpr uint32_t kLevelSlots = 1u << kLevelBits;
+        static constexpr uint32_t kLevelCount = 4;
+        // farther expiries are clamped
+        static constexpr uint64_t kMaxDelay = (1ull << (kLevelBits * kLevelCount)) - 1;
+
+        explicit TimerWheel(uint64_t now = 0) : m_nNow(now)
+        {
+            for (auto& level : m_Slots)
+                for (auto& slot : level)
+                    slot = kNil;
+        }
+
+        // schedule value for tick expire, ticks already passed fire on the next Advance
+        TimerHandle Insert(uint64_t expire, const T& value)
+        {
+            uint32_t index;
+            if (m_nFree != kNil)
+            {
+                index = m_nFree;
+                m_nFree = m_Nodes[index].Next;
+            }
+            else
+            {
+                index = static_cast<uint32_t>(m_Nodes.size());
+                m_Nodes.emplace_back();
+            }
+            Node& node = m_Nodes[index];
+            node.Expire = expire < m_nNow ? m_nNow : expire;
+            node.Value = value;
+            node.Live = true;
+            Link(index);
+            ++m_nCount;
+            ++m_nLinked;
+            return (static_cast<uint64_t>(node.Generation) << 32) | (index + 1);
+        }
+
+        // the entry stays in its slot and is dropped when its tick comes
+        bool Cancel(TimerHandle handle)
+        {
+            uint32_t index = static_cast<uint32_t>(handle) - 1;
+            if (handle == kInvalidTimerHandle || index >= m_Nodes.size())
+                return false;
+            Node& node = m_Nodes[index];
+            if (!node.Live || node.Generation != static_cast<uint32_t>(handle >> 32))
+                return false;
+            node.Live = false;
+            --m_nCount;
+            return true;
+        }
+
+        // run every tick up to and including now, fire(value) for each entry due
+        template<typename Fn>
+        void Advance(uint64_t now, Fn&& fire)
+        {
+            while (m_nNow <= now)
+            {
+                // nothing left, jump ahead. Cancelled entries still in slots
+                // are dropped by Clear
+                if (m_nCount == 0)
+                {
+                    if (m_nLinked > 0)
+                        Clear();
+                    m_nNow = now + 1;
+                    return;
+                }
+
+                uint32_t slot = static_cast<uint32_t>(m_nNow & (kLevelSlots - 1));
+                if (slot == 0)
+                    Cascade();
+
+                uint32_t index = m_Slots[0][slot];
+                m_Slots[0][slot] = kNil;
+                // inserts from fire belong to the next tick
+                ++m_nNow;
+                while (index != kNil)
+                {
+                    uint32_t next = m_Nodes[index].Next;
+                    if (m_Nodes[index].Live)
+                    {
+                        // fire may insert and grow the array
+                        T value = std::move(m_Nodes[index].Value);
+                        Release(index);
+                        --m_nCount;
+                        fire(value);
+                    }
+                    else
+                        Release(index);
+                    index = next;
+                }
+            }
+        }
+
+        uint64_t GetNow() const { return m_nNow; }
+        size_t GetCount() const { return m_nCount; }
+
+    private:
+        static constexpr uint32_t kNil = ~0u;
+
+        struct Node
+        {
+            uint64_t Expire = 0;
+            uint32_t Next = kNil;
+            uint32_t Generation = 1;
+            bool Live = false;
+            T Value{};
+        };
+
+        void Link(uint32_t index)
+        {
+            Node& node = m_Nodes[index];
+            uint64_t delay = node.Expire - m_nNow;
+            if (delay > kMaxDelay)
+            {
+                delay = kMaxDelay;
+                node.Expire = m_nNow + kMaxDelay;
+            }
+
+            uint32_t level = 0;
+            while (level + 1 < kLevelCount && delay >= (1ull << (kLevelBits * (level + 1))))
+                ++level;
+            uint32_t slot = static_cast<uint32_t>(node.Expire >> (kLevelBits * level)) & (kLevelSlots - 1);
+            node.Next = m_Slots[level][slot];
+            m_Slots[level][slot] = index;
+        }
+
+        // level 0 wrapped: bring the current slot of each level above down,
+        // going up as long as the level below wrapped as well
+        void Cascade()
+        {
+            for (uint32_t level = 1; level < kLevelCount; ++level)
+            {
+                uint32_t slot = static_cast<uint32_t>(m_nNow >> (kLevelBits * level)) & (kLevelSlots - 1);
+                uint32_t index = m_Slots[level][slot];
+                m_Slots[level][slot] = kNil;
+                while (index != kNil)
+                {
+                    uint32_t next = m_Nodes[index].Next;
+                    if (m_Nodes[index].Live)
+                        Link(index);
+                    else
+                        Release(index);
+                    index = next;
+                }
+                if (slot != 0)
+                    break;
+            }
+        }
+
+        void Release(uint32_t index)
+        {
+            Node& node = m_Nodes[index];
+            node.Live = false;
+            node.Value = T{};
+            ++node.Generation;
+            node.Next = m_nFree;
+            m_nFree = index;
+            --m_nLinked;
+        }
+
+        void Clear()
+        {
+            for (auto& level : m_Slots)
+            {
+                for (auto& slot : level)
+                {
+                    uint32_t index = slot;
+                    slot = kNil;
+                    while (index != kNil)
+                    {
+                        uint32_t next = m_Nodes[index].Next;
+                        Release(index);
+                        index = next;
+                    }
+                }
+            }
+        }
+
+        std::vector<Node> m_Nodes;
+        uint32_t m_Slots[kLevelCount][kLevelSlots];
+        uint32_t m_nFree = kNil;
+        uint64_t m_nNow;        // next tick to run
+        size_t m_nCount = 0;    // live entries
+        size_t m_nLinked = 0;   // entries in slots, cancelled ones included
+    };
+}
@@ -0,0 +1,12 @@
+#include "Headless/HeadlessWindow.h"
+
+using namespace Rocket;
+
+void HeadlessWindow::Initialize()
+{
+	RK_CORE_INFO("Creating Headless Window {0} ({1}, {2})", m_Props.Title, m_Props.Width, m_Props.Height);
+}
+
+void HeadlessWindow::Finalize()
+{
+}
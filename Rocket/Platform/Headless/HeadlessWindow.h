@@ -0,0 +1,19 @@
+#pragma once
+#include "Common/Window.h"
+
+namespace Rocket
+{
+    // Window without a display, for servers and CI. It only keeps the
+    // size, there is no native window and no input from it
+    class HeadlessWindow : implements Window
+	{
+	public:
+		HeadlessWindow(const WindowProps &prop) : Window(prop) {}
+		virtual ~HeadlessWindow() = default;
+
+        void Initialize() final;
+		void Finalize() final;
+
+		void* GetNativeWindow() const final { return nullptr; }
+	};
+}
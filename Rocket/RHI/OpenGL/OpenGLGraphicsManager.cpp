@@ -2,6 +2,7 @@
 #include "Module/WindowManager.h"
 #include "Module/Application.h"
 #include "Module/MemoryManager.h"
+#include "Common/ObjectPool.h"
 
 #include "Scene/Scene.h"
 #include "Scene/Component/PlanarMesh.h"
@@ -249,7 +250,7 @@ void OpenGLGraphicsManager::BeginScene(const Scene& scene)
     auto planar_meshes = m_CurrentScene->GetComponents<PlanarMesh>();
     for (auto mesh : planar_meshes)
     {
-        auto dbc = CreateRef<OpenGLDrawBatchContext>();
+        auto dbc = CreatePooledRef<OpenGLDrawBatchContext>();
         auto vertex = mesh->GetVertex();
         auto index = mesh->GetIndex();
         dbc->VAO = CreateRef<OpenGLVertexArray>();
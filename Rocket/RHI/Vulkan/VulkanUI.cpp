@@ -2,6 +2,8 @@
 #include "Vulkan/VulkanFunction.h"
 #include "Vulkan/VulkanShader.h"
 #include "Module/AssetLoader.h"
+#include "Module/MemoryManager.h"
+#include "Common/MemoryResource.h"
 
 // ImGui Implements
 #include <backends/imgui_impl_glfw.cpp>
@@ -272,6 +274,32 @@ void VulkanUI::UpdataOverlay(uint32_t width, uint32_t height)
 	ImGui::ColorEdit3("clear color", (float*)&clearColor);
 	ImGui::End();
 
+	// size class stats, only gathered while the window is open
+	if (g_MemoryManager)
+	{
+		if (ImGui::Begin("Memory"))
+		{
+			auto stats = g_MemoryManager->GetStats();
+			ImGui::Text("Committed %zu KB / Reserved %zu MB", stats.CommittedBytes / 1024, stats.ReservedBytes / (1024 * 1024));
+			ImGui::Text("Large %zu allocations, %zu KB", stats.LargeAllocations, stats.LargeBytes / 1024);
+			ImGui::Separator();
+			ImGui::Text("Size:Align  Live  Peak  Frag  Waste");
+			for (const auto& size_class : stats.SizeClasses)
+			{
+				if (size_class.Pages == 0)
+					continue;
+				ImGui::Text("%4zu:%-2zu  %6zu  %6zu  %3.0f%%  %zu B",
+					size_class.BlockSize, size_class.Alignment, size_class.LiveBlocks, size_class.PeakLiveBlocks,
+					size_class.Fragmentation() * 100.0, size_class.RoundingWaste());
+			}
+			ImGui::Separator();
+			ImGui::Text("Resource  Live  Peak");
+			for (const auto& resource : GetMemoryResourceStats())
+				ImGui::Text("%-10s  %zu KB  %zu KB", resource.Name, resource.LiveBytes / 1024, resource.PeakBytes / 1024);
+		}
+		ImGui::End();
+	}
+
 	ImGui::Render();
 
 	if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
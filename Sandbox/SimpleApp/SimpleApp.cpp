@@ -1,5 +1,6 @@
 #include "SimpleApp.h"
 #include "Module/MemoryManager.h"
+#include "Module/JobManager.h"
 #include "Module/AssetLoader.h"
 #include "Module/AudioManager.h"
 #include "Module/WindowManager.h"
@@ -22,6 +23,7 @@ namespace Rocket
 {
     Application* g_Application;
     MemoryManager* g_MemoryManager;
+    JobManager* g_JobManager;
     AssetLoader* g_AssetLoader;
     AudioManager* g_AudioManager;
     WindowManager* g_WindowManager;
@@ -40,23 +42,41 @@ namespace Rocket
     void SimpleApp::PreInitializeModule()
     {
         g_MemoryManager = GetMemoryManager();
+        g_JobManager = GetJobManager();
         g_AssetLoader = GetAssetLoader();
         g_ProcessManager = GetProcessManager();
         g_AudioManager = GetAudioManager();
         g_SceneManager = GetSceneManager();
         g_WindowManager = GetWindowManager();
-        g_GraphicsManager = GetGraphicsManager();
-        g_PipelineStateManager = GetPipelineStateManager();
         g_EventManager = GetEventManager();
 
+        // size classes are fixed once the memory manager initializes
+        auto& config = GetConfig();
+        // a headless run has nothing to render to
+        bool headless = config->HasConfigInfo("Graphics", "headless") && config->GetConfigInfo<bool>("Graphics", "headless");
+        if (!headless)
+        {
+            g_GraphicsManager = GetGraphicsManager();
+            g_PipelineStateManager = GetPipelineStateManager();
+        }
+        g_MemoryManager->SetSizeClassFile(config->GetConfigInfo<String>("Memory", "size_class_file"));
+        g_MemoryManager->SetRecordFile(config->GetConfigInfo<String>("Memory", "record_file"));
+        g_EventManager->SetThreadQueue(
+            config->GetConfigInfo<uint32_t>("Event", "thread_queue_capacity"),
+            config->GetConfigInfo<String>("Event", "thread_queue_overflow"));
+
         PushModule(g_MemoryManager);
+        PushModule(g_JobManager);
         PushModule(g_AssetLoader);
         PushModule(g_ProcessManager);
         PushModule(g_AudioManager);
         PushModule(g_SceneManager);
         PushModule(g_WindowManager);
-        PushModule(g_GraphicsManager);
-        PushModule(g_PipelineStateManager);
+        if (!headless)
+        {
+            PushModule(g_GraphicsManager);
+            PushModule(g_PipelineStateManager);
+        }
         PushModule(g_EventManager);
     }
 
@@ -65,13 +85,17 @@ namespace Rocket
         bool ret = false;
         ret = g_EventManager->AddListener(
             REGISTER_DELEGATE_CLASS(Application::OnWindowClose, *g_Application), 
-            EventHashTable::HashString("window_close"));
-        ret = g_EventManager->AddListener(
-            REGISTER_DELEGATE_CLASS(GraphicsManager::OnWindowResize, *g_GraphicsManager), 
-            EventHashTable::HashString("window_resize"));
-        ret = g_EventManager->AddListener(
-            REGISTER_DELEGATE_CLASS(WindowManager::OnWindowResize, *g_WindowManager), 
-            EventHashTable::HashString("window_resize"));
+            "window_close"_sid);
+        if (g_GraphicsManager)
+        {
+            ret = g_EventManager->AddListener(
+                REGISTER_DELEGATE_CLASS(GraphicsManager::OnWindowResize, *g_GraphicsManager), 
+                "window_resize"_sid);
+        }
+        g_EventManager->GetChannel<WindowResize>().Connect<&WindowManager::OnWindowResize>(*g_WindowManager);
+        SetJobSystem(&g_JobManager->GetJobSystem());
+        g_ProcessManager->SetJobSystem(&g_JobManager->GetJobSystem());
+        g_EventManager->SetJobSystem(&g_JobManager->GetJobSystem());
         RK_CORE_ASSERT(ret, "Application PostInitializeModule Failed");
     }
 
@@ -0,0 +1,91 @@
+// Cursor moves through EventManager::TriggerEvent to listeners unpacking
+// the Variant payload, against the same listeners on a typed EventChannel,
+// published to directly and bridged from the string id event.
+#include "Module/EventManager.h"
+#include "Module/WindowManager.h"
+#include "Module/MemoryManager.h"
+#include "Event/InputEvents.h"
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+namespace Rocket
+{
+    MemoryManager* g_MemoryManager;
+    WindowManager* g_WindowManager;
+}
+
+using namespace Rocket;
+
+static const size_t kEvents = 1 << 22;
+static const size_t kListeners = 4;
+
+static double s_Sum = 0.0;
+
+struct Listener
+{
+    bool OnEvent(EventPtr& event)
+    {
+        s_Sum += event->GetDouble(1) + event->GetDouble(2);
+        return false;
+    }
+
+    bool OnMouseMove(const MouseMove& event)
+    {
+        s_Sum += event.X + event.Y;
+        return false;
+    }
+};
+
+template<typename Fn>
+static double Run(Fn&& fn)
+{
+    auto begin = chrono::steady_clock::now();
+    for (size_t i = 0; i < kEvents; ++i)
+        fn(i);
+    auto end = chrono::steady_clock::now();
+    return kEvents / chrono::duration<double>(end - begin).count();
+}
+
+int main()
+{
+    Log::Init(LogLevel::WARN);
+
+    g_MemoryManager = GetMemoryManager();
+    if (g_MemoryManager->Initialize() != 0)
+        return 1;
+
+    vector<Listener> listeners(kListeners);
+    vector<Event> events;
+    vector<MouseMove> moves;
+    for (size_t i = 0; i < 1024; ++i)
+    {
+        events.push_back(Event("mouse_move"_sid));
+        events.back().AddDouble(double(i)).AddDouble(double(i * 2));
+        moves.push_back({double(i), double(i * 2)});
+    }
+
+    auto* variant = new EventManager(false);
+    for (auto& listener : listeners)
+        variant->AddListener(REGISTER_DELEGATE_CLASS(Listener::OnEvent, listener), "mouse_move"_sid);
+
+    auto* typed = new EventManager(false);
+    auto& channel = typed->GetChannel<MouseMove>();
+    for (auto& listener : listeners)
+        channel.Connect<&Listener::OnMouseMove>(listener);
+
+    cout << kListeners << " listeners" << endl;
+    cout << "variant:       " << Run([&](size_t i) { variant->TriggerEvent(events[i % events.size()]); }) << " events/s" << endl;
+    cout << "typed bridged: " << Run([&](size_t i) { typed->TriggerEvent(events[i % events.size()]); }) << " events/s" << endl;
+    cout << "typed:         " << Run([&](size_t i) { channel.Publish(moves[i % moves.size()]); }) << " events/s" << endl;
+    cout << "(checksum " << s_Sum << ")" << endl;
+
+    delete typed;
+    delete variant;
+    g_MemoryManager->Finalize();
+    delete g_MemoryManager;
+    return 0;
+}
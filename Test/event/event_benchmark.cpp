@@ -0,0 +1,237 @@
+// Events per second through EventManager, queued on the main thread with
+// QueueEvent and from other threads with ThreadSafeQueueEvent, dispatched
+// by Update. The manager runs without a window, Initialize is not called.
+// Also checks that a lane listener filling a blocking thread queue while
+// the main thread waits for its lane does not hang or lose events.
+#include "Module/EventManager.h"
+#include "Module/WindowManager.h"
+#include "Module/MemoryManager.h"
+#include "Utils/JobSystem.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace Rocket
+{
+    MemoryManager* g_MemoryManager;
+    WindowManager* g_WindowManager;
+}
+
+using namespace Rocket;
+
+static const size_t kEvents = 1 << 22;
+// events queued between two updates, a busy frame of mouse input
+static const size_t kEventsPerFrame = 1024;
+
+static atomic<uint64_t> s_Handled{0};
+
+static bool OnMouseMove(EventPtr& event)
+{
+    if (event->GetDouble(1) >= 0.0)
+        s_Handled.fetch_add(1, memory_order_relaxed);
+    return false;
+}
+
+// a handler doing real work, a few microseconds per event
+struct HeavyListener
+{
+    bool OnEvent(EventPtr& event)
+    {
+        double sum = 0.0;
+        for (int i = 0; i < 2000; ++i)
+            sum += event->GetDouble(1) * i;
+        if (sum >= 0.0)
+            s_Handled.fetch_add(1, memory_order_relaxed);
+        return false;
+    }
+};
+
+static double RunQueue(EventManager& manager, EventType type)
+{
+    auto begin = chrono::steady_clock::now();
+    for (size_t i = 0; i < kEvents / kEventsPerFrame; ++i)
+    {
+        for (size_t j = 0; j < kEventsPerFrame; ++j)
+        {
+            Event event(type);
+            event.AddDouble(double(j)).AddDouble(double(i));
+            manager.QueueEvent(event);
+        }
+        manager.Update(~0ull);
+    }
+    auto end = chrono::steady_clock::now();
+    return kEvents / chrono::duration<double>(end - begin).count();
+}
+
+static double RunThreadSafeQueue(EventManager& manager, EventType type, uint32_t num_producers)
+{
+    vector<thread> producers;
+    size_t per_producer = kEvents / num_producers;
+    atomic<uint32_t> finished{0};
+
+    auto begin = chrono::steady_clock::now();
+    for (uint32_t t = 0; t < num_producers; ++t)
+    {
+        producers.emplace_back([&]() {
+            for (size_t i = 0; i < per_producer; ++i)
+            {
+                Event event(type);
+                event.AddDouble(double(i)).AddDouble(0.0);
+                manager.ThreadSafeQueueEvent(event);
+            }
+            finished.fetch_add(1);
+        });
+    }
+    // the main thread keeps updating until every producer is done, then
+    // picks up what is left
+    while (finished.load() < num_producers)
+        manager.Update(~0ull);
+    for (auto& producer : producers)
+        producer.join();
+    manager.Update(~0ull);
+    auto end = chrono::steady_clock::now();
+    return per_producer * num_producers / chrono::duration<double>(end - begin).count();
+}
+
+// queues more than the thread queue holds from its lane, the main thread
+// waits for the lane in the next Update and pops nothing meanwhile
+struct FloodListener
+{
+    EventManager* Manager = nullptr;
+    EventType Echo = 0;
+    size_t Count = 0;
+
+    bool OnEvent(EventPtr& event)
+    {
+        for (size_t i = 0; i < Count; ++i)
+        {
+            Event echo(Echo);
+            echo.AddDouble(double(i)).AddDouble(0.0);
+            Manager->ThreadSafeQueueEvent(echo);
+        }
+        return false;
+    }
+};
+
+static bool CheckLaneFlood(EventManager& manager)
+{
+    static const size_t kCapacity = 64;
+    manager.SetThreadQueue(kCapacity, "block");
+    FloodListener flood;
+    flood.Manager = &manager;
+    flood.Echo = EventHashTable::HashString("flood_echo");
+    flood.Count = kCapacity * 8;
+    EventType type = EventHashTable::HashString("flood_event");
+    auto listener = REGISTER_DELEGATE_CLASS(FloodListener::OnEvent, flood);
+    manager.AddListener(listener, type, EventLaneFromName("flood"));
+    manager.AddListener(REGISTER_DELEGATE_FN(OnMouseMove), flood.Echo);
+
+    uint64_t handled = s_Handled.load();
+    manager.QueueEvent(Event(type));
+    // dispatches to the lane, waits for it, then takes the echoes
+    for (int i = 0; i < 3; ++i)
+        manager.Update(~0ull);
+    uint64_t echoes = s_Handled.load() - handled;
+
+    manager.RemoveListener(listener, type);
+    manager.RemoveListener(REGISTER_DELEGATE_FN(OnMouseMove), flood.Echo);
+    cout << "Lane flooding a blocking thread queue: " << echoes << " of " << flood.Count << " events" << endl;
+    return echoes == flood.Count;
+}
+
+// main thread milliseconds per frame spent in Update with the heavy
+// listeners on the given lanes
+static double RunLanes(EventManager& manager, EventType type, size_t frames)
+{
+    double update_ms = 0.0;
+    for (size_t i = 0; i < frames; ++i)
+    {
+        for (size_t j = 0; j < 64; ++j)
+        {
+            Event event(type);
+            event.AddDouble(double(j));
+            manager.QueueEvent(event);
+        }
+        auto begin = chrono::steady_clock::now();
+        manager.Update(~0ull);
+        update_ms += chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+        // the rest of the frame, lanes run meanwhile
+        this_thread::sleep_for(chrono::milliseconds(2));
+    }
+    return update_ms / frames;
+}
+
+int main()
+{
+    Log::Init(LogLevel::WARN);
+
+    // queues and listener lists live in MemoryManager size classes
+    g_MemoryManager = GetMemoryManager();
+    if (g_MemoryManager->Initialize() != 0)
+        return 1;
+
+    g_EventTimer = new ElapseTimer();
+    g_EventTimer->Start();
+
+    // runs the lanes
+    JobSystem jobs;
+    auto* manager = new EventManager(false);
+    manager->SetJobSystem(&jobs);
+    EventType type = EventHashTable::HashString("mouse_move");
+    manager->AddListener(REGISTER_DELEGATE_FN(OnMouseMove), type);
+
+    cout << "sizeof(Event) " << sizeof(Event) << endl;
+    cout << "QueueEvent + Update: " << RunQueue(*manager, type) << " events/s" << endl;
+    // one listener call per frame left
+    manager->SetCoalesce(type, EventCoalesce::KeepLatest);
+    uint64_t handled = s_Handled.load();
+    double rate = RunQueue(*manager, type);
+    cout << "QueueEvent + Update, keep latest: " << rate << " events/s, " << (s_Handled.load() - handled) << " listener calls" << endl;
+    manager->SetCoalesce(type, EventCoalesce::KeepAll);
+
+    uint32_t max_threads = thread::hardware_concurrency();
+    if (max_threads == 0)
+        max_threads = 4;
+    for (const char* overflow : {"spill", "block", "drop_oldest"})
+    {
+        for (uint32_t n = 1; n <= max_threads; n *= 2)
+        {
+            manager->SetThreadQueue(4096, overflow);
+            uint64_t handled = s_Handled.load();
+            double rate = RunThreadSafeQueue(*manager, type, n);
+            cout << "ThreadSafeQueueEvent " << overflow << ", " << n << " producers: " << rate << " events/s, "
+                 << (kEvents / n * n - (s_Handled.load() - handled)) << " dropped" << endl;
+        }
+    }
+
+    // four heavy listeners on the main thread, then each on its own lane
+    static const char* kLanes[] = {"physics", "audio", "streaming", "ai"};
+    HeavyListener heavy_listeners[4];
+    EventType heavy = EventHashTable::HashString("heavy_event");
+    for (auto& listener : heavy_listeners)
+        manager->AddListener(REGISTER_DELEGATE_CLASS(HeavyListener::OnEvent, listener), heavy);
+    cout << "Update, heavy listeners on main thread: " << RunLanes(*manager, heavy, 64) << " ms/frame" << endl;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        auto listener = REGISTER_DELEGATE_CLASS(HeavyListener::OnEvent, heavy_listeners[i]);
+        manager->RemoveListener(listener, heavy);
+        manager->AddListener(listener, heavy, EventLaneFromName(kLanes[i]));
+    }
+    cout << "Update, heavy listeners on lanes: " << RunLanes(*manager, heavy, 64) << " ms/frame" << endl;
+
+    bool flooded = CheckLaneFlood(*manager);
+    if (!flooded)
+        cout << "  WRONG events lost" << endl;
+
+    delete manager;
+    delete g_EventTimer;
+    g_EventTimer = nullptr;
+    g_MemoryManager->Finalize();
+    delete g_MemoryManager;
+    return flooded ? 0 : 1;
+}
@@ -0,0 +1,123 @@
+// Listener dispatch cost of EventManager::TriggerEvent, dense type ids and
+// one listener array per type, against the map of linked lists it replaced.
+#include "Module/EventManager.h"
+#include "Module/WindowManager.h"
+#include "Module/MemoryManager.h"
+
+#include <chrono>
+#include <iostream>
+#include <list>
+#include <map>
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+namespace Rocket
+{
+    MemoryManager* g_MemoryManager;
+    WindowManager* g_WindowManager;
+}
+
+using namespace Rocket;
+
+static const size_t kEvents = 1 << 22;
+// about what the engine registers: window, mouse and key events
+static const size_t kTypes = 32;
+static const size_t kListenersPerType = 4;
+
+static uint64_t s_Calls = 0;
+
+struct Listener
+{
+    bool OnEvent(EventPtr& event)
+    {
+        s_Calls += event->Count;
+        return false;
+    }
+};
+
+// dispatch as it was: tree lookup on the string id, then a linked list
+class MapListDispatcher
+{
+public:
+    void AddListener(const EventListenerDelegate& listener, EventType type) { m_Listeners[type].push_back(listener); }
+
+    bool TriggerEvent(Event& event)
+    {
+        EventPtr pEvent = &event;
+        auto findIt = m_Listeners.find(event.GetEventType());
+        if (findIt == m_Listeners.end())
+            return false;
+        for (auto& listener : findIt->second)
+        {
+            if (listener(pEvent))
+                return true;
+        }
+        return false;
+    }
+
+private:
+    map<EventType, list<EventListenerDelegate>> m_Listeners;
+};
+
+template<typename Dispatcher>
+static double Run(Dispatcher& dispatcher, vector<Event>& events)
+{
+    auto begin = chrono::steady_clock::now();
+    for (size_t i = 0; i < kEvents; ++i)
+        dispatcher.TriggerEvent(events[i % events.size()]);
+    auto end = chrono::steady_clock::now();
+    return kEvents / chrono::duration<double>(end - begin).count();
+}
+
+int main()
+{
+    Log::Init(LogLevel::WARN);
+
+    g_MemoryManager = GetMemoryManager();
+    if (g_MemoryManager->Initialize() != 0)
+        return 1;
+
+    vector<EventType> types;
+    for (size_t i = 0; i < kTypes; ++i)
+        types.push_back(EventHashTable::HashString("benchmark_event_" + to_string(i)));
+
+    vector<Listener> listeners(kTypes * kListenersPerType);
+    auto* manager = new EventManager(false);
+    MapListDispatcher mapList;
+    // other allocations between registrations, list nodes end up spread
+    // over the heap the way modules registering at different times leave them
+    vector<unique_ptr<char[]>> churn;
+    for (size_t l = 0; l < kListenersPerType; ++l)
+    {
+        for (size_t t = 0; t < kTypes; ++t)
+        {
+            auto listener = REGISTER_DELEGATE_CLASS(Listener::OnEvent, listeners[t * kListenersPerType + l]);
+            manager->AddListener(listener, types[t]);
+            mapList.AddListener(listener, types[t]);
+            for (size_t i = 0; i < 16; ++i)
+                churn.emplace_back(new char[64 + (t * 37 + i * 11) % 512]);
+        }
+    }
+
+    // a frame worth of events in a mixed order, built once so only the
+    // dispatch is measured
+    vector<Event> events;
+    uint32_t seed = 1;
+    for (size_t i = 0; i < 1024; ++i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        events.push_back(Event(types[(seed >> 8) % kTypes]));
+        events.back().AddDouble(double(i));
+    }
+
+    cout << kTypes << " types, " << kListenersPerType << " listeners each" << endl;
+    cout << "map + list:  " << Run(mapList, events) << " events/s" << endl;
+    cout << "dense array: " << Run(*manager, events) << " events/s" << endl;
+
+    delete manager;
+    g_MemoryManager->Finalize();
+    delete g_MemoryManager;
+    return 0;
+}
@@ -0,0 +1,100 @@
+// Cost of scheduling timed events: the TimerWheel behind
+// EventManager::QueueEventAt against a binary heap ordered by expiry.
+// Events get random delays up to a minute and expire over 16 ms frames.
+#include "Interface/IEvent.h"
+#include "Utils/TimerWheel.h"
+
+#include <chrono>
+#include <iostream>
+#include <queue>
+#include <vector>
+
+using namespace std;
+
+namespace Rocket
+{
+    ElapseTimer* g_EventTimer;
+}
+
+using namespace Rocket;
+
+static const size_t kTimers = 1 << 20;
+static const uint64_t kMaxDelay = 60000;
+static const uint64_t kFrame = 16;
+
+struct HeapEntry
+{
+    uint64_t Expire;
+    Event Data;
+    bool operator<(const HeapEntry& rhs) const { return Expire > rhs.Expire; }
+};
+
+struct Result
+{
+    double InsertNs;
+    double ExpireNs;
+    size_t Fired;
+};
+
+static Result RunWheel(const vector<uint64_t>& delays, const Event& event)
+{
+    TimerWheel<Event> wheel;
+    size_t fired = 0;
+
+    auto begin = chrono::steady_clock::now();
+    for (uint64_t delay : delays)
+        wheel.Insert(delay, event);
+    auto inserted = chrono::steady_clock::now();
+    for (uint64_t now = 0; wheel.GetCount() > 0; now += kFrame)
+        wheel.Advance(now, [&](const Event& e) { fired += e.Count; });
+    auto end = chrono::steady_clock::now();
+
+    return {chrono::duration<double, nano>(inserted - begin).count() / delays.size(),
+            chrono::duration<double, nano>(end - inserted).count() / delays.size(), fired};
+}
+
+static Result RunHeap(const vector<uint64_t>& delays, const Event& event)
+{
+    priority_queue<HeapEntry> heap;
+    size_t fired = 0;
+
+    auto begin = chrono::steady_clock::now();
+    for (uint64_t delay : delays)
+        heap.push({delay, event});
+    auto inserted = chrono::steady_clock::now();
+    for (uint64_t now = 0; !heap.empty(); now += kFrame)
+    {
+        while (!heap.empty() && heap.top().Expire <= now)
+        {
+            fired += heap.top().Data.Count;
+            heap.pop();
+        }
+    }
+    auto end = chrono::steady_clock::now();
+
+    return {chrono::duration<double, nano>(inserted - begin).count() / delays.size(),
+            chrono::duration<double, nano>(end - inserted).count() / delays.size(), fired};
+}
+
+int main()
+{
+    Log::Init(LogLevel::WARN);
+
+    vector<uint64_t> delays(kTimers);
+    uint32_t seed = 1;
+    for (auto& delay : delays)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        delay = (seed >> 8) % kMaxDelay;
+    }
+
+    Event event("timer_benchmark"_sid);
+    event.AddDouble(1.0);
+
+    Result heap = RunHeap(delays, event);
+    Result wheel = RunWheel(delays, event);
+    cout << kTimers << " timed events, delays up to " << kMaxDelay << " ms" << endl;
+    cout << "binary heap: insert " << heap.InsertNs << " ns, expire " << heap.ExpireNs << " ns" << endl;
+    cout << "timer wheel: insert " << wheel.InsertNs << " ns, expire " << wheel.ExpireNs << " ns" << endl;
+    return heap.Fired == wheel.Fired ? 0 : 1;
+}
@@ -0,0 +1,173 @@
+// Fine grained parallel work on the JobSystem against std::async and, when
+// its headers are installed, taskflow:
+//   parallel for  sqrt over 4M floats in small ranges
+//   fib           recursive spawning down to small subtrees
+//   tiny jobs     many independent jobs doing next to nothing
+#include "Utils/JobSystem.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <future>
+#include <iostream>
+#include <vector>
+
+#if __has_include(<taskflow/taskflow.hpp>)
+#include <taskflow/taskflow.hpp>
+#define RK_BENCHMARK_TASKFLOW 1
+#endif
+
+using namespace std;
+using namespace Rocket;
+
+static const size_t kElements = 1 << 22;
+static const int kFib = 30;
+// below this fib runs serially
+static const int kFibCutoff = 12;
+static const size_t kTinyJobs = 1 << 18;
+
+template<typename Fn>
+static double Measure(Fn&& fn)
+{
+    auto begin = chrono::steady_clock::now();
+    fn();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - begin).count();
+}
+
+static void Transform(vector<float>& data, size_t begin, size_t end)
+{
+    for (size_t i = begin; i < end; ++i)
+        data[i] = sqrtf(data[i] + 1.0f);
+}
+
+static uint64_t SerialFib(int n)
+{
+    return n < 2 ? n : SerialFib(n - 1) + SerialFib(n - 2);
+}
+
+static void JobFib(JobSystem& jobs, int n, atomic<uint64_t>& out)
+{
+    if (n < kFibCutoff)
+    {
+        out.fetch_add(SerialFib(n), memory_order_relaxed);
+        return;
+    }
+    jobs.Spawn([&jobs, n, &out]() { JobFib(jobs, n - 1, out); });
+    JobFib(jobs, n - 2, out);
+}
+
+// one thread per subtree down to depth, std::async cannot go finer
+static uint64_t AsyncFib(int n, int depth)
+{
+    if (n < kFibCutoff || depth == 0)
+        return SerialFib(n);
+    auto left = async(launch::async, AsyncFib, n - 1, depth - 1);
+    uint64_t right = AsyncFib(n - 2, depth - 1);
+    return left.get() + right;
+}
+
+#if defined(RK_BENCHMARK_TASKFLOW)
+static void TaskflowFib(int n, atomic<uint64_t>& out, tf::Subflow& subflow)
+{
+    if (n < kFibCutoff)
+    {
+        out.fetch_add(SerialFib(n), memory_order_relaxed);
+        return;
+    }
+    subflow.emplace([n, &out](tf::Subflow& child) { TaskflowFib(n - 1, out, child); });
+    subflow.emplace([n, &out](tf::Subflow& child) { TaskflowFib(n - 2, out, child); });
+    subflow.join();
+}
+#endif
+
+int main()
+{
+    JobSystem jobs;
+    uint32_t threads = jobs.GetThreadCount();
+    cout << threads << " threads" << endl;
+
+    vector<float> data(kElements, 1.0f);
+    cout << "parallel for, " << kElements << " elements" << endl;
+    cout << "  serial              " << Measure([&]() { Transform(data, 0, kElements); }) << " ms" << endl;
+    for (size_t grain : {256, 4096})
+    {
+        cout << "  jobs grain " << grain << (grain < 1000 ? "      " : "     ") << Measure([&]() {
+            jobs.ParallelFor(0, kElements, grain, [&](size_t begin, size_t end) { Transform(data, begin, end); });
+        }) << " ms" << endl;
+    }
+    // one thread per range, finer ranges only measure thread creation
+    cout << "  async grain 65536   " << Measure([&]() {
+        vector<future<void>> futures;
+        for (size_t begin = 0; begin < kElements; begin += 65536)
+            futures.push_back(async(launch::async, Transform, ref(data), begin, min(begin + 65536, kElements)));
+        for (auto& future : futures)
+            future.get();
+    }) << " ms" << endl;
+#if defined(RK_BENCHMARK_TASKFLOW)
+    tf::Executor executor(threads);
+    for (size_t grain : {256, 4096})
+    {
+        cout << "  taskflow grain " << grain << (grain < 1000 ? "  " : " ") << Measure([&]() {
+            tf::Taskflow taskflow;
+            taskflow.for_each_index(size_t(0), kElements, grain, [&](size_t begin) {
+                Transform(data, begin, min(begin + grain, kElements));
+            });
+            executor.run(taskflow).wait();
+        }) << " ms" << endl;
+    }
+#endif
+
+    // volatile so the serial run is not folded away
+    volatile int fib = kFib;
+    uint64_t expected = 0;
+    cout << "fib " << kFib << ", serial below " << kFibCutoff << endl;
+    cout << "  serial              " << Measure([&]() { expected = SerialFib(fib); }) << " ms" << endl;
+    atomic<uint64_t> result{0};
+    cout << "  jobs                " << Measure([&]() {
+        JobCounter counter;
+        jobs.Run(counter, [&]() { JobFib(jobs, kFib, result); });
+        jobs.Wait(counter);
+    }) << " ms" << (result == expected ? "" : " WRONG") << endl;
+    uint64_t async_result = 0;
+    cout << "  async depth 6       " << Measure([&]() { async_result = AsyncFib(kFib, 6); }) << " ms"
+         << (async_result == expected ? "" : " WRONG") << endl;
+#if defined(RK_BENCHMARK_TASKFLOW)
+    result = 0;
+    cout << "  taskflow            " << Measure([&]() {
+        tf::Taskflow taskflow;
+        taskflow.emplace([&](tf::Subflow& subflow) { TaskflowFib(kFib, result, subflow); });
+        executor.run(taskflow).wait();
+    }) << " ms" << (result == expected ? "" : " WRONG") << endl;
+#endif
+
+    atomic<uint64_t> counted{0};
+    cout << "tiny jobs, per job" << endl;
+    double ms = Measure([&]() {
+        JobCounter counter;
+        for (size_t i = 0; i < kTinyJobs; ++i)
+            jobs.Run(counter, [&counted]() { counted.fetch_add(1, memory_order_relaxed); });
+        jobs.Wait(counter);
+    });
+    cout << "  jobs                " << ms * 1e6 / kTinyJobs << " ns" << endl;
+    // a thread each, so fewer of them
+    size_t async_jobs = kTinyJobs / 64;
+    ms = Measure([&]() {
+        vector<future<void>> futures;
+        futures.reserve(async_jobs);
+        for (size_t i = 0; i < async_jobs; ++i)
+            futures.push_back(async(launch::async, [&counted]() { counted.fetch_add(1, memory_order_relaxed); }));
+        for (auto& future : futures)
+            future.get();
+    });
+    cout << "  async               " << ms * 1e6 / async_jobs << " ns" << endl;
+#if defined(RK_BENCHMARK_TASKFLOW)
+    ms = Measure([&]() {
+        for (size_t i = 0; i < kTinyJobs; ++i)
+            executor.silent_async([&counted]() { counted.fetch_add(1, memory_order_relaxed); });
+        executor.wait_for_all();
+    });
+    cout << "  taskflow            " << ms * 1e6 / kTinyJobs << " ns" << endl;
+#endif
+    return 0;
+}
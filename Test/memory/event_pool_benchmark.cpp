@@ -0,0 +1,114 @@
+#include "Event/Event.h"
+#include "Common/ObjectPool.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace Rocket
+{
+    ElapseTimer* g_EventTimer;
+}
+
+using namespace Rocket;
+
+// event as it was before events became plain records: polymorphic, with
+// the payload in a separately allocated Variant array
+struct HeapEvent : PoolObject
+{
+    HeapEvent(const Ref<Variant>& var, uint32_t count) : Var(var), Count(count)
+    {
+        TimeStamp = g_EventTimer->GetExactTime();
+    }
+    virtual ~HeapEvent() = default;
+
+    EventType GetEventType() const { return Var.get()[0].m_asStringId; }
+
+    bool Handled = false;
+    double TimeStamp = 0.0;
+    Ref<Variant> Var;
+    uint32_t Count;
+};
+
+static const size_t kEventsPerThread = 1 << 20;
+// events alive at once, about what a busy frame queues
+static const size_t kLiveEvents = 256;
+
+template<typename PtrType, typename CreateFn>
+static double RunCreate(uint32_t num_threads, const Ref<Variant>& var, CreateFn create)
+{
+    atomic<bool> start{false};
+    vector<thread> threads;
+
+    for (uint32_t t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back([&]() {
+            vector<PtrType> events(kLiveEvents);
+            while (!start.load(memory_order_acquire)) {}
+
+            for (size_t i = 0; i < kEventsPerThread / kLiveEvents; ++i)
+            {
+                for (auto& event : events)
+                    event = create(var);
+                // a listener looking at the event and the queue dropping it
+                for (auto& event : events)
+                {
+                    if constexpr (std::is_same_v<PtrType, Event>)
+                        event.Handled = event.GetEventType() != 0;
+                    else
+                    {
+                        event->Handled = event->GetEventType() != 0;
+                        event.reset();
+                    }
+                }
+            }
+        });
+    }
+
+    auto begin = chrono::steady_clock::now();
+    start.store(true, memory_order_release);
+    for (auto& thread : threads)
+        thread.join();
+    auto end = chrono::steady_clock::now();
+
+    double seconds = chrono::duration<double>(end - begin).count();
+    return static_cast<double>(num_threads) * kEventsPerThread / seconds;
+}
+
+int main()
+{
+    Log::Init(LogLevel::WARN);
+
+    g_EventTimer = new ElapseTimer();
+    g_EventTimer->Start();
+
+    // the variant array is shared, only the event object is measured
+    Ref<Variant> var = Ref<Variant>(new Variant[1], [](Variant* p) { delete[] p; });
+    var.get()[0].type = Variant::TYPE_STRING_ID;
+    var.get()[0].m_asStringId = EventHashTable::HashString("benchmark");
+
+    uint32_t max_threads = thread::hardware_concurrency();
+    if (max_threads == 0)
+        max_threads = 4;
+
+    cout << "threads\tCreateRef(events/s)\tCreatePoolRef(events/s)\tby value(events/s)" << endl;
+    for (uint32_t n = 1; n <= max_threads; n *= 2)
+    {
+        double shared = RunCreate<Ref<HeapEvent>>(n, var,
+            [](const Ref<Variant>& v) { return CreateRef<HeapEvent>(v, 1); });
+        double pooled = RunCreate<PoolRef<HeapEvent>>(n, var,
+            [](const Ref<Variant>& v) { return CreatePoolRef<HeapEvent>(v, 1); });
+        double record = RunCreate<Event>(n, var,
+            [](const Ref<Variant>& v) { return Event(v.get()[0].m_asStringId); });
+        cout << n << "\t" << shared << "\t" << pooled << "\t" << record << endl;
+    }
+    cout << "pool capacity " << ObjectPool<HeapEvent>::Get().GetCapacity()
+         << ", live " << ObjectPool<HeapEvent>::Get().GetLive() << endl;
+
+    delete g_EventTimer;
+    return 0;
+}
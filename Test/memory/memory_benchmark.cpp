@@ -0,0 +1,94 @@
+#include "Module/MemoryManager.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace Rocket
+{
+    MemoryManager* g_MemoryManager;
+}
+
+using namespace Rocket;
+
+static const size_t kOpsPerThread = 1 << 20;
+static const size_t kLiveBlocks = 256;
+
+// small object sizes spread over every size class
+static size_t NextSize(uint32_t& seed)
+{
+    seed = seed * 1664525u + 1013904223u;
+    return 4 + (seed >> 8) % 1020;
+}
+
+template<typename AllocFn, typename FreeFn>
+static double RunContention(uint32_t num_threads, AllocFn alloc, FreeFn dealloc)
+{
+    atomic<bool> start{false};
+    vector<thread> threads;
+
+    for (uint32_t t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back([&, t]() {
+            void* blocks[kLiveBlocks] = {};
+            size_t sizes[kLiveBlocks] = {};
+            uint32_t seed = t + 1;
+            while (!start.load(memory_order_acquire)) {}
+
+            for (size_t i = 0; i < kOpsPerThread / kLiveBlocks; ++i)
+            {
+                for (size_t j = 0; j < kLiveBlocks; ++j)
+                {
+                    sizes[j] = NextSize(seed);
+                    blocks[j] = alloc(sizes[j]);
+                    *static_cast<uint8_t*>(blocks[j]) = static_cast<uint8_t>(j);
+                }
+                for (size_t j = 0; j < kLiveBlocks; ++j)
+                    dealloc(blocks[j], sizes[j]);
+            }
+        });
+    }
+
+    auto begin = chrono::steady_clock::now();
+    start.store(true, memory_order_release);
+    for (auto& thread : threads)
+        thread.join();
+    auto end = chrono::steady_clock::now();
+
+    double seconds = chrono::duration<double>(end - begin).count();
+    // one allocate and one free per op
+    return static_cast<double>(num_threads) * kOpsPerThread * 2 / seconds;
+}
+
+int main()
+{
+    Log::Init(LogLevel::WARN);
+
+    g_MemoryManager = GetMemoryManager();
+    if (g_MemoryManager->Initialize() != 0)
+        return 1;
+
+    uint32_t max_threads = thread::hardware_concurrency();
+    if (max_threads == 0)
+        max_threads = 4;
+
+    cout << "threads\tMemoryManager(ops/s)\tmalloc(ops/s)\tratio" << endl;
+    for (uint32_t n = 1; n <= max_threads; n *= 2)
+    {
+        double pool = RunContention(n,
+            [](size_t size) { return g_MemoryManager->Allocate(size); },
+            [](void* p, size_t size) { g_MemoryManager->Free(p, size); });
+        double system = RunContention(n,
+            [](size_t size) { return malloc(size); },
+            [](void* p, size_t) { free(p); });
+        cout << n << "\t" << pool << "\t" << system << "\t" << pool / system << endl;
+    }
+
+    g_MemoryManager->Finalize();
+    delete g_MemoryManager;
+    return 0;
+}
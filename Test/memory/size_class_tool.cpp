@@ -0,0 +1,274 @@
+// Builds a size class table from a histogram recorded by MemoryManager
+// (Config/setting-memory.yaml record_file) and writes it in the format
+// read back through size_class_file.
+//
+// usage: size_class_tool <histogram> <table> [max_size_classes]
+//
+// Every size class costs the bytes lost rounding its requests up, the tail
+// of each page its blocks do not fill, and about half a page that is never
+// full. Costs are scaled to the peak live footprint of the recorded run, and
+// classes / page size are picked to minimize the sum.
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// must match MemoryManager.cpp
+static const uint32_t kAlignments[] = { 4, 16, 32, 64 };
+static const uint32_t kNumTables = sizeof(kAlignments) / sizeof(kAlignments[0]);
+static const uint32_t kMaxBlockSize = 1024;
+static const uint32_t kMaxSizeClasses = 128;
+static const uint32_t kBuiltinClasses[kNumTables] = { 47, 28, 20, 16 };
+static const uint32_t kPageSizes[] = { 4096, 8192, 16384, 32768, 65536 };
+// smallest block, a free block has to hold a pointer
+static const uint32_t kMinBlockSize = sizeof(void*);
+// PageHeader of BlockAllocator: list links, free list and live count
+static const uint32_t kPageHeaderSize = 4 * sizeof(void*);
+
+static const double kInfinity = numeric_limits<double>::infinity();
+
+struct Histogram
+{
+    vector<uint64_t> Counts[kNumTables];
+    uint64_t PeakLiveBytes = 0;
+    uint32_t PageSize = 0;
+};
+
+struct TablePlan
+{
+    // Cost[k] and Classes[k] of the best layout with k size classes
+    vector<double> Cost;
+    vector<vector<uint32_t>> Classes;
+};
+
+static bool LoadHistogram(const string& path, Histogram& histogram)
+{
+    ifstream file(path);
+    if (!file.is_open())
+        return false;
+
+    for (auto& counts : histogram.Counts)
+        counts.assign(kMaxBlockSize + 1, 0);
+
+    string line;
+    while (getline(file, line))
+    {
+        istringstream words(line);
+        string key;
+        if (!(words >> key) || key[0] == '#')
+            continue;
+        if (key == "page_size")
+            words >> histogram.PageSize;
+        else if (key == "peak_live_bytes")
+            words >> histogram.PeakLiveBytes;
+        else if (key == "size")
+        {
+            uint32_t alignment, size;
+            uint64_t count;
+            words >> alignment >> size >> count;
+            for (uint32_t t = 0; t < kNumTables; ++t)
+            {
+                if (kAlignments[t] == alignment && size <= kMaxBlockSize)
+                    histogram.Counts[t][size] += count;
+            }
+        }
+    }
+    return true;
+}
+
+static uint32_t AlignUp(uint32_t size, uint32_t alignment) { return (size + alignment - 1) & ~(alignment - 1); }
+
+// optimal layouts of one table for every class count, O(k * n^2) dynamic programming
+static TablePlan PlanTable(const vector<uint64_t>& counts, uint32_t alignment, uint32_t page_size, double scale, uint32_t max_classes)
+{
+    // prefix sums over request sizes
+    vector<double> num(kMaxBlockSize + 2, 0.0), bytes(kMaxBlockSize + 2, 0.0);
+    for (uint32_t s = 0; s <= kMaxBlockSize; ++s)
+    {
+        num[s + 1] = num[s] + counts[s];
+        bytes[s + 1] = bytes[s] + double(counts[s]) * s;
+    }
+
+    vector<uint32_t> candidates;
+    for (uint32_t c = AlignUp(kMinBlockSize, alignment); c <= kMaxBlockSize; c += alignment)
+        candidates.push_back(c);
+    size_t n = candidates.size();
+    uint32_t header = AlignUp(kPageHeaderSize, alignment);
+
+    // cost of one class of size c serving the requests in (lo, c]
+    auto segment = [&](uint32_t lo, uint32_t c) {
+        double requests = num[c + 1] - num[lo];
+        // an unused class has no pages, a token cost keeps it from being picked for nothing
+        if (requests == 0.0)
+            return 1.0;
+        double rounding = (requests * c - (bytes[c + 1] - bytes[lo])) * scale;
+        double live = requests * c * scale;
+        uint32_t blocks = (page_size - header) / c;
+        double used = double(blocks) * c / page_size;
+        return rounding + live * (1.0 - used) / used + double(page_size) / 2;
+    };
+
+    // best[k][j], k + 1 classes with the largest one at candidates[j]
+    vector<vector<double>> best(max_classes, vector<double>(n, kInfinity));
+    vector<vector<int32_t>> from(max_classes, vector<int32_t>(n, -1));
+    for (size_t j = 0; j < n; ++j)
+        best[0][j] = segment(0, candidates[j]);
+    for (uint32_t k = 1; k < max_classes; ++k)
+    {
+        for (size_t j = k; j < n; ++j)
+        {
+            for (size_t i = k - 1; i < j; ++i)
+            {
+                double cost = best[k - 1][i] + segment(candidates[i] + 1, candidates[j]);
+                if (cost < best[k][j])
+                {
+                    best[k][j] = cost;
+                    from[k][j] = static_cast<int32_t>(i);
+                }
+            }
+        }
+    }
+
+    // every table has to end with kMaxBlockSize
+    TablePlan plan;
+    plan.Cost.assign(max_classes + 1, kInfinity);
+    plan.Classes.resize(max_classes + 1);
+    for (uint32_t k = 0; k < max_classes && k < n; ++k)
+    {
+        plan.Cost[k + 1] = best[k][n - 1];
+        int32_t j = static_cast<int32_t>(n - 1);
+        for (int32_t level = k; level >= 0 && j >= 0; --level)
+        {
+            plan.Classes[k + 1].push_back(candidates[j]);
+            j = from[level][j];
+        }
+        reverse(plan.Classes[k + 1].begin(), plan.Classes[k + 1].end());
+    }
+    return plan;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        cout << "usage: size_class_tool <histogram> <table> [max_size_classes]" << endl;
+        return 1;
+    }
+
+    Histogram histogram;
+    if (!LoadHistogram(argv[1], histogram))
+    {
+        cout << "cannot read " << argv[1] << endl;
+        return 1;
+    }
+    uint32_t budget = argc > 3 ? static_cast<uint32_t>(stoul(argv[3])) : kMaxSizeClasses;
+    budget = min(budget, kMaxSizeClasses);
+
+    // tables without samples keep their built-in layout
+    bool sampled[kNumTables];
+    double requested_bytes = 0.0;
+    for (uint32_t t = 0; t < kNumTables; ++t)
+    {
+        sampled[t] = false;
+        for (uint32_t s = 0; s <= kMaxBlockSize; ++s)
+        {
+            sampled[t] = sampled[t] || histogram.Counts[t][s] > 0;
+            requested_bytes += double(histogram.Counts[t][s]) * s;
+        }
+        if (!sampled[t])
+            budget -= min(budget, kBuiltinClasses[t]);
+    }
+    if (requested_bytes == 0.0)
+    {
+        cout << "histogram is empty" << endl;
+        return 1;
+    }
+    // costs are counted per request, scale them to the live footprint
+    double scale = histogram.PeakLiveBytes > 0 ? double(histogram.PeakLiveBytes) / requested_bytes : 1.0;
+
+    double best_cost = kInfinity;
+    uint32_t best_page_size = 0;
+    vector<uint32_t> best_tables[kNumTables];
+
+    for (uint32_t page_size : kPageSizes)
+    {
+        TablePlan plans[kNumTables];
+        for (uint32_t t = 0; t < kNumTables; ++t)
+        {
+            if (sampled[t])
+                plans[t] = PlanTable(histogram.Counts[t], kAlignments[t], page_size, scale, budget);
+        }
+
+        // split the class budget between the tables
+        vector<double> total(budget + 1, 0.0);
+        vector<vector<uint32_t>> split(budget + 1, vector<uint32_t>(kNumTables, 0));
+        for (uint32_t t = 0; t < kNumTables; ++t)
+        {
+            if (!sampled[t])
+                continue;
+            vector<double> next(budget + 1, kInfinity);
+            vector<vector<uint32_t>> next_split(budget + 1);
+            for (uint32_t used = 0; used <= budget; ++used)
+            {
+                if (total[used] == kInfinity)
+                    continue;
+                for (uint32_t k = 1; used + k <= budget && k < plans[t].Cost.size(); ++k)
+                {
+                    double cost = total[used] + plans[t].Cost[k];
+                    if (cost < next[used + k])
+                    {
+                        next[used + k] = cost;
+                        next_split[used + k] = split[used];
+                        next_split[used + k][t] = k;
+                    }
+                }
+            }
+            total.swap(next);
+            split.swap(next_split);
+        }
+
+        auto it = min_element(total.begin(), total.end());
+        if (*it < best_cost)
+        {
+            best_cost = *it;
+            best_page_size = page_size;
+            const auto& counts = split[it - total.begin()];
+            for (uint32_t t = 0; t < kNumTables; ++t)
+                best_tables[t] = sampled[t] ? plans[t].Classes[counts[t]] : vector<uint32_t>();
+        }
+        cout << "page size " << page_size << "\testimated overhead " << uint64_t(*it) << " bytes" << endl;
+    }
+
+    if (best_page_size == 0)
+    {
+        cout << "no valid layout within the size class budget" << endl;
+        return 1;
+    }
+
+    ofstream file(argv[2]);
+    if (!file.is_open())
+    {
+        cout << "cannot write " << argv[2] << endl;
+        return 1;
+    }
+    file << "# generated by size_class_tool from " << argv[1] << "\n";
+    file << "page_size " << best_page_size << "\n";
+    for (uint32_t t = 0; t < kNumTables; ++t)
+    {
+        if (best_tables[t].empty())
+            continue;
+        file << "table " << kAlignments[t];
+        for (auto size : best_tables[t])
+            file << ' ' << size;
+        file << "\n";
+        cout << "alignment " << kAlignments[t] << ": " << best_tables[t].size() << " size classes" << endl;
+    }
+    cout << "page size " << best_page_size << " written to " << argv[2] << endl;
+    return 0;
+}
@@ -0,0 +1,337 @@
+// Fiber processes: checks first, then the cost of a resume
+//   yield        resumed on each of the following ticks
+//   wait for     resumed on the first tick its time is over
+//   await        resumed on the tick the awaited process ended, or the
+//                next one when that was a script
+//   abort        suspended scripts see their wait fail and return, one
+//                that carries on is dropped, both get OnAbort
+//   stack reuse  fibers of finished processes run the next ones
+//   any thread   resumed on the job system, the others on this thread,
+//                may unpause other processes
+#include "Module/ProcessManager.h"
+
+#include <chrono>
+#include <iostream>
+#include <set>
+#include <thread>
+
+using namespace std;
+using namespace Rocket;
+
+static const unsigned long kDeltaMs = 16;
+static const size_t kFibers = 10000;
+static const int kYields = 100;
+
+static int s_nTick = 0;
+static int s_nFailed = 0;
+
+static void Check(bool ok, const char* what)
+{
+    if (ok)
+        return;
+    cout << "  WRONG " << what << endl;
+    ++s_nFailed;
+}
+
+class YieldProcess : public FiberProcess
+{
+public:
+    explicit YieldProcess(int count, bool any_thread = false) : FiberProcess(any_thread), m_nCount(count) {}
+
+    Vec<int> Ticks;
+    std::thread::id Thread;
+
+protected:
+    virtual void Run(void) override
+    {
+        Thread = std::this_thread::get_id();
+        for (int i = 0; i < m_nCount; ++i)
+        {
+            Ticks.push_back(s_nTick);
+            if (!Yield())
+                return;
+        }
+    }
+
+private:
+    int m_nCount;
+};
+
+class WaitProcess : public FiberProcess
+{
+public:
+    explicit WaitProcess(uint64_t ms) : m_nMs(ms) {}
+
+    int Started = -1;
+    int Resumed = -1;
+    bool Aborted = false;
+
+protected:
+    virtual void Run(void) override
+    {
+        Started = s_nTick;
+        if (!WaitFor(m_nMs))
+            return;
+        Resumed = s_nTick;
+    }
+    virtual void OnAbort(void) override { Aborted = true; }
+
+private:
+    uint64_t m_nMs;
+};
+
+class TimerProcess : public Process
+{
+public:
+    explicit TimerProcess(int ticks) : m_nLeft(ticks) {}
+
+    int Ended = -1;
+
+protected:
+    virtual void OnUpdate(unsigned long deltaMs) override
+    {
+        if (--m_nLeft == 0)
+            Succeed();
+    }
+    virtual void OnSuccess(void) override { Ended = s_nTick; }
+
+private:
+    int m_nLeft;
+};
+
+class AwaitProcess : public FiberProcess
+{
+public:
+    explicit AwaitProcess(StrongProcessPtr pProcess) : m_pProcess(pProcess) {}
+
+    int Resumed = -1;
+    bool Succeeded = false;
+
+protected:
+    virtual void Run(void) override
+    {
+        if (!Await(m_pProcess))
+            return;
+        Resumed = s_nTick;
+        Succeeded = m_pProcess->GetState() == SUCCEEDED;
+    }
+
+private:
+    StrongProcessPtr m_pProcess;
+};
+
+// ignores its waits failing
+class StubbornProcess : public FiberProcess
+{
+public:
+    bool Aborted = false;
+
+protected:
+    virtual void Run(void) override
+    {
+        for (;;)
+            Yield();
+    }
+    virtual void OnAbort(void) override { Aborted = true; }
+};
+
+// unpauses another process from wherever it runs
+class UnPauseProcess : public FiberProcess
+{
+public:
+    explicit UnPauseProcess(StrongProcessPtr pProcess) : FiberProcess(true), m_pProcess(pProcess) {}
+
+protected:
+    virtual void Run(void) override
+    {
+        Yield();
+        m_pProcess->UnPause();
+    }
+
+private:
+    StrongProcessPtr m_pProcess;
+};
+
+class PausedProcess : public Process
+{
+public:
+    int Updates = 0;
+
+protected:
+    virtual void OnInit(void) override
+    {
+        Process::OnInit();
+        Pause();
+    }
+    virtual void OnUpdate(unsigned long deltaMs) override
+    {
+        if (++Updates == 2)
+            Succeed();
+    }
+};
+
+// records where its stack is
+class StackProcess : public FiberProcess
+{
+public:
+    explicit StackProcess(std::set<const void*>* pStacks) : m_pStacks(pStacks) {}
+
+protected:
+    virtual void Run(void) override
+    {
+        int local = 0;
+        m_pStacks->insert(&local);
+        Yield();
+    }
+
+private:
+    std::set<const void*>* m_pStacks;
+};
+
+static void Update(ProcessManager& manager, int ticks = 1)
+{
+    for (int i = 0; i < ticks; ++i)
+    {
+        ++s_nTick;
+        manager.UpdateProcesses(kDeltaMs);
+    }
+}
+
+static void CheckOrdering(ProcessManager& manager)
+{
+    auto yield = CreateRef<YieldProcess>(3);
+    auto wait = CreateRef<WaitProcess>(100);
+    auto timer = CreateRef<TimerProcess>(5);
+    auto await_timer = CreateRef<AwaitProcess>(timer);
+    auto await_fiber = CreateRef<AwaitProcess>(wait);
+    for (StrongProcessPtr pProcess : {StrongProcessPtr(yield), StrongProcessPtr(wait), StrongProcessPtr(timer),
+        StrongProcessPtr(await_timer), StrongProcessPtr(await_fiber)})
+        manager.AttachProcess(pProcess);
+    int start = s_nTick + 1;
+    Update(manager, 20);
+
+    Check(yield->Ticks == Vec<int>({start, start + 1, start + 2}) && yield->GetState() == Process::SUCCEEDED, "yield");
+    // 100 ms are seven ticks of 16
+    Check(wait->Started == start && wait->Resumed == start + 7, "wait for");
+    // fibers are resumed after the processes, a script ending waits for the next update
+    Check(timer->Ended == start + 4 && await_timer->Resumed == timer->Ended && await_timer->Succeeded, "await process");
+    Check(await_fiber->Resumed == wait->Resumed + 1 && await_fiber->Succeeded, "await fiber process");
+    Check(manager.GetProcessCount() == 0, "ordering processes left");
+}
+
+static void CheckAbort(ProcessManager& manager)
+{
+    auto wait = CreateRef<WaitProcess>(1000000);
+    auto stubborn = CreateRef<StubbornProcess>();
+    manager.AttachProcess(wait);
+    manager.AttachProcess(stubborn);
+    Update(manager, 3);
+    manager.AbortAllProcesses(false);
+    Update(manager);
+    Check(wait->Aborted && wait->Resumed == -1 && stubborn->Aborted, "abort while suspended");
+    Check(manager.GetProcessCount() == 0, "abort processes left");
+
+    wait = CreateRef<WaitProcess>(1000000);
+    manager.AttachProcess(wait);
+    Update(manager);
+    manager.AbortAllProcesses(true);
+    Check(wait->Aborted && manager.GetProcessCount() == 0, "immediate abort while suspended");
+}
+
+static void CheckStackReuse(ProcessManager& manager)
+{
+    std::set<const void*> first;
+    std::set<const void*> second;
+    for (size_t i = 0; i < 16; ++i)
+        manager.AttachProcess(CreateRef<StackProcess>(&first));
+    Update(manager, 3);
+    for (size_t i = 0; i < 16; ++i)
+        manager.AttachProcess(CreateRef<StackProcess>(&second));
+    Update(manager, 3);
+    bool reused = !second.empty();
+    for (auto stack : second)
+        reused = reused && first.count(stack) > 0;
+    Check(reused, "stack reuse");
+}
+
+static void CheckAnyThread(ProcessManager& manager, JobSystem& jobs)
+{
+    Vec<Ref<YieldProcess>> any_thread;
+    Vec<Ref<YieldProcess>> main_thread;
+    for (size_t i = 0; i < 256; ++i)
+    {
+        any_thread.push_back(CreateRef<YieldProcess>(4, true));
+        main_thread.push_back(CreateRef<YieldProcess>(4));
+        manager.AttachProcess(any_thread.back());
+        manager.AttachProcess(main_thread.back());
+    }
+    Vec<Ref<PausedProcess>> paused;
+    for (size_t i = 0; i < 256; ++i)
+    {
+        paused.push_back(CreateRef<PausedProcess>());
+        manager.AttachProcess(paused.back());
+        manager.AttachProcess(CreateRef<UnPauseProcess>(paused.back()));
+    }
+    Update(manager, 5);
+
+    bool unpaused = true;
+    for (auto& pProcess : paused)
+        unpaused = unpaused && pProcess->GetState() == Process::SUCCEEDED && pProcess->Updates == 2;
+    Check(unpaused, "unpaused from any thread");
+
+    std::set<std::thread::id> threads;
+    bool done = true;
+    for (auto& pProcess : any_thread)
+    {
+        threads.insert(pProcess->Thread);
+        done = done && pProcess->GetState() == Process::SUCCEEDED && pProcess->Ticks.size() == 4;
+    }
+    bool main_only = true;
+    for (auto& pProcess : main_thread)
+    {
+        done = done && pProcess->GetState() == Process::SUCCEEDED && pProcess->Ticks.size() == 4;
+        main_only = main_only && pProcess->Thread == std::this_thread::get_id();
+    }
+    Check(done, "any thread resumption");
+    Check(main_only, "main thread fibers off the main thread");
+    cout << "  any thread fibers started on " << threads.size() << " of " << jobs.GetThreadCount() << " threads" << endl;
+}
+
+int main()
+{
+    cout << "checks" << endl;
+    {
+        // workers even on a single core, for the any thread ones
+        JobSystem jobs(3);
+        ProcessManager manager;
+        manager.Initialize();
+        manager.SetJobSystem(&jobs);
+        CheckOrdering(manager);
+        CheckAbort(manager);
+        CheckStackReuse(manager);
+        CheckAnyThread(manager, jobs);
+        manager.Finalize();
+    }
+
+    JobSystem jobs;
+    ProcessManager manager;
+    manager.Initialize();
+    manager.SetJobSystem(&jobs);
+
+    cout << kFibers << " fibers yielding " << kYields << " times, per resume" << endl;
+    for (bool any_thread : {false, true})
+    {
+        for (size_t i = 0; i < kFibers; ++i)
+            manager.AttachProcess(CreateRef<YieldProcess>(kYields, any_thread));
+        // the first tick creates the fibers
+        Update(manager);
+        auto begin = chrono::steady_clock::now();
+        Update(manager, kYields);
+        auto end = chrono::steady_clock::now();
+        cout << (any_thread ? "  any thread   " : "  main thread  ")
+             << chrono::duration<double, nano>(end - begin).count() / (kFibers * kYields) << " ns" << endl;
+    }
+
+    manager.Finalize();
+    return s_nFailed;
+}
@@ -0,0 +1,192 @@
+// Update cost of 100k processes of which 1% run every tick, the rest
+// either paused or waiting a long time:
+//   list      every process in one list visited each tick, waiting ones
+//             count their own time down in OnUpdate
+//   buckets   ProcessManager, paused and sleeping ones are not looked at
+// and of 100k tweens all running, as plain processes and as parallel ones
+// on the job system
+#include "Module/ProcessManager.h"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <list>
+
+using namespace std;
+using namespace Rocket;
+
+static const size_t kProcesses = 100000;
+static const size_t kActive = kProcesses / 100;
+static const int kTicks = 1000;
+static const unsigned long kDeltaMs = 16;
+// longer than the benchmark runs
+static const unsigned long kWaitMs = 1000000;
+
+static uint64_t s_Updates = 0;
+static const float kTweenMs = 1000000.0f;
+
+class ActiveProcess : public Process
+{
+protected:
+    virtual void OnUpdate(unsigned long deltaMs) override { s_Updates += deltaMs; }
+};
+
+class PausedProcess : public Process
+{
+protected:
+    virtual void OnInit(void) override
+    {
+        Process::OnInit();
+        Pause();
+    }
+    virtual void OnUpdate(unsigned long deltaMs) override { s_Updates += deltaMs; }
+};
+
+// counts down itself, all a process could do before SleepFor
+class WaitingProcess : public Process
+{
+protected:
+    virtual void OnUpdate(unsigned long deltaMs) override
+    {
+        m_nElapsed += deltaMs;
+        if (m_nElapsed < kWaitMs)
+            return;
+        s_Updates += deltaMs;
+    }
+
+private:
+    unsigned long m_nElapsed = 0;
+};
+
+class SleepingProcess : public Process
+{
+protected:
+    virtual void OnUpdate(unsigned long deltaMs) override { SleepFor(kWaitMs); }
+};
+
+// the process kinds mixed the way a scene would attach them
+template<typename Waiting>
+static void CreateProcesses(Vec<StrongProcessPtr>& processes)
+{
+    for (size_t i = 0; i < kProcesses; ++i)
+    {
+        if (i % 100 == 0)
+            processes.push_back(CreateRef<ActiveProcess>());
+        else if (i % 2 == 0)
+            processes.push_back(CreateRef<PausedProcess>());
+        else
+            processes.push_back(CreateRef<Waiting>());
+    }
+}
+
+// the update loop ProcessManager had, less the dead process handling
+class ListProcessManager
+{
+public:
+    void AttachProcess(StrongProcessPtr pProcess) { m_ProcessList.push_front(pProcess); }
+
+    void UpdateProcesses(unsigned long deltaMs)
+    {
+        for (auto& pProcess : m_ProcessList)
+        {
+            if (pProcess->GetState() == Process::UNINITIALIZED)
+                CallInit(pProcess.get());
+            if (pProcess->GetState() == Process::RUNNING)
+                CallUpdate(pProcess.get(), deltaMs);
+        }
+    }
+
+private:
+    // the hooks are protected, reach them as the subclasses do
+    struct Access : Process
+    {
+        static void Init(Process* pProcess) { (pProcess->*&Access::OnInit)(); }
+        static void Update(Process* pProcess, unsigned long deltaMs) { (pProcess->*&Access::OnUpdate)(deltaMs); }
+    };
+    static void CallInit(Process* pProcess) { Access::Init(pProcess); }
+    static void CallUpdate(Process* pProcess, unsigned long deltaMs) { Access::Update(pProcess, deltaMs); }
+
+    std::list<StrongProcessPtr> m_ProcessList;
+};
+
+template<typename Manager>
+static double MeasureTicks(Manager& manager)
+{
+    // the first tick initializes and sorts them
+    manager.UpdateProcesses(kDeltaMs);
+    auto begin = chrono::steady_clock::now();
+    for (int i = 0; i < kTicks; ++i)
+        manager.UpdateProcesses(kDeltaMs);
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, micro>(end - begin).count() / kTicks;
+}
+
+// eases a value of its own, never done within the benchmark
+template<typename Base>
+class TweenProcess : public Base
+{
+protected:
+    virtual void OnUpdate(unsigned long deltaMs) override
+    {
+        m_fElapsed += static_cast<float>(deltaMs);
+        float t = std::min(m_fElapsed / kTweenMs, 1.0f);
+        m_fValue = t * t * (3.0f - 2.0f * t) + std::sin(t);
+        if (t >= 1.0f)
+            Base::Succeed();
+    }
+
+private:
+    float m_fElapsed = 0.0f;
+    float m_fValue = 0.0f;
+};
+
+template<typename Base>
+static double MeasureTweens(JobSystem* jobs)
+{
+    Vec<Ref<TweenProcess<Base>>> tweens;
+    ProcessManager manager;
+    manager.Initialize();
+    manager.SetJobSystem(jobs);
+    for (size_t i = 0; i < kProcesses; ++i)
+    {
+        tweens.push_back(CreateRef<TweenProcess<Base>>());
+        manager.AttachProcess(tweens.back());
+    }
+    double us = MeasureTicks(manager);
+    manager.Finalize();
+    return us;
+}
+
+int main()
+{
+    cout << kProcesses << " processes, " << kActive << " active, per tick" << endl;
+
+    {
+        Vec<StrongProcessPtr> processes;
+        CreateProcesses<WaitingProcess>(processes);
+        ListProcessManager manager;
+        for (auto& pProcess : processes)
+            manager.AttachProcess(pProcess);
+        cout << "  list      " << MeasureTicks(manager) << " us" << endl;
+    }
+
+    {
+        Vec<StrongProcessPtr> processes;
+        CreateProcesses<SleepingProcess>(processes);
+        ProcessManager manager;
+        manager.Initialize();
+        for (auto& pProcess : processes)
+            manager.AttachProcess(pProcess);
+        double us = MeasureTicks(manager);
+        cout << "  buckets   " << us << " us, " << us * 1000.0 / kActive << " ns per active process" << endl;
+        manager.Finalize();
+    }
+
+    JobSystem jobs;
+    cout << kProcesses << " tweens, per tick, " << jobs.GetThreadCount() << " threads" << endl;
+    cout << "  serial    " << MeasureTweens<Process>(&jobs) << " us" << endl;
+    cout << "  parallel  " << MeasureTweens<ParallelProcess>(&jobs) << " us" << endl;
+
+    // keeps the updates from being optimized away
+    return s_Updates == 0;
+}